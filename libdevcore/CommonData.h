@@ -27,6 +27,7 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <vector>
 #include <type_traits>
 #include <cstring>
@@ -157,17 +158,69 @@ inline void toBigEndian(T _val, Out& o_out)
 	}
 }
 
-/// Converts a big-endian byte-stream represented on a templated collection to a templated integer value.
-/// @a _In will typically be either std::string or bytes.
-/// @a T will typically by unsigned, u160, u256 or bigint.
+/// Faster version of toBigEndian for u256, which extracts eight bytes at a time
+/// instead of shifting the whole number for every byte.
+template <class Out>
+inline void toBigEndian(u256 const& _val, Out& o_out)
+{
+	size_t const size = o_out.size();
+	u256 remaining = _val;
+	for (size_t i = 0; i < size; i += 8)
+	{
+		uint64_t word = 0;
+		if (remaining != 0)
+		{
+			word = (remaining & u256(0xffffffffffffffff)).convert_to<uint64_t>();
+			remaining >>= 64;
+		}
+		for (size_t j = 0; j < 8 && i + j < size; ++j, word >>= 8)
+			o_out[size - 1 - i - j] = (typename Out::value_type)(uint8_t)word;
+	}
+}
+
+namespace detail
+{
 template <class T, class _In>
-inline T fromBigEndian(_In const& _bytes)
+inline T fromBigEndian(_In const& _bytes, T*)
 {
 	T ret = (T)0;
 	for (auto i: _bytes)
 		ret = (T)((ret << 8) | (uint8_t)(typename std::make_unsigned<typename _In::value_type>::type)i);
 	return ret;
 }
+
+/// Combines eight bytes at a time instead of shifting the whole number for every byte.
+template <class _In>
+inline u256 fromBigEndian(_In const& _bytes, u256*)
+{
+	u256 ret = 0;
+	uint64_t word = 0;
+	size_t wordBytes = 0;
+	// The first word takes the bytes that do not fill a complete word.
+	size_t wordSize = _bytes.size() % 8 ? _bytes.size() % 8 : 8;
+	for (auto i: _bytes)
+	{
+		word = (word << 8) | (uint8_t)(typename std::make_unsigned<typename _In::value_type>::type)i;
+		if (++wordBytes == wordSize)
+		{
+			ret = (ret << (8 * wordSize)) | word;
+			word = 0;
+			wordBytes = 0;
+			wordSize = 8;
+		}
+	}
+	return ret;
+}
+}
+
+/// Converts a big-endian byte-stream represented on a templated collection to a templated integer value.
+/// @a _In will typically be either std::string or bytes.
+/// @a T will typically by unsigned, u160, u256 or bigint.
+template <class T, class _In>
+inline T fromBigEndian(_In const& _bytes)
+{
+	return detail::fromBigEndian(_bytes, static_cast<T*>(nullptr));
+}
 inline bytes toBigEndian(u256 _val) { bytes ret(32); toBigEndian(_val, ret); return ret; }
 inline bytes toBigEndian(u160 _val) { bytes ret(20); toBigEndian(_val, ret); return ret; }
 
@@ -187,6 +240,13 @@ inline bytes toCompactBigEndian(uint8_t _val, unsigned _min = 0)
 {
 	return (_min || _val) ? bytes{ _val } : bytes{};
 }
+inline bytes toCompactBigEndian(u256 const& _val, unsigned _min = 0)
+{
+	unsigned size = _val == 0 ? 0 : unsigned(boost::multiprecision::msb(_val) / 8 + 1);
+	bytes ret(std::max(_min, size), 0);
+	toBigEndian(_val, ret);
+	return ret;
+}
 
 /// Workarounds shift left bug in boost <1.65.1.
 template <class S> S bigintShiftLeftWorkaround(S const& _a, unsigned _b)
@@ -222,9 +282,11 @@ inline std::string formatNumber(u256 const& _value)
 
 inline std::string toCompactHexWithPrefix(u256 val)
 {
-	std::ostringstream ret;
-	ret << std::hex << val;
-	return "0x" + ret.str();
+	std::string hex = toHex(toCompactBigEndian(val, 1));
+	// Like std::hex, do not print a leading zero digit.
+	if (hex.size() > 1 && hex[0] == '0')
+		hex.erase(0, 1);
+	return "0x" + hex;
 }
 
 // Algorithms for string and string-like collections.
@@ -238,6 +300,10 @@ inline unsigned bytesRequired(T _i)
 	for (; _i != 0; ++i, _i >>= 8) {}
 	return i;
 }
+inline unsigned bytesRequired(u256 const& _i)
+{
+	return _i == 0 ? 0 : unsigned(boost::multiprecision::msb(_i) / 8 + 1);
+}
 template <class T, class V>
 bool contains(T const& _t, V const& _v)
 {
@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Timing and memory instrumentation of compiler phases.
+ */
+
+#include <libdevcore/Profiler.h>
+
+#include <libdevcore/Assertions.h>
+#include <libdevcore/Exceptions.h>
+
+#include <boost/format.hpp>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace dev;
+
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::reset()
+{
+	assertThrow(m_current == 0, Exception, "Profiler reset while a phase is running.");
+	m_phases.clear();
+	m_phases.emplace_back();
+	m_counters.clear();
+}
+
+void Profiler::start(string const& _name)
+{
+	size_t index = 0;
+	for (size_t child: m_phases[m_current].children)
+		if (m_phases[child].name == _name)
+		{
+			index = child;
+			break;
+		}
+	if (index == 0)
+	{
+		index = m_phases.size();
+		m_phases.emplace_back();
+		m_phases.back().name = _name;
+		m_phases.back().parent = m_current;
+		m_phases[m_current].children.push_back(index);
+	}
+
+	Phase& phase = m_phases[index];
+	phase.calls++;
+	phase.start = Clock::now();
+	m_current = index;
+}
+
+void Profiler::stop()
+{
+	assertThrow(m_current != 0, Exception, "No phase running.");
+	Phase& phase = m_phases[m_current];
+	phase.total += Clock::now() - phase.start;
+	m_current = phase.parent;
+}
+
+Json::Value Profiler::toJson() const
+{
+	Json::Value ret = toJson(m_phases.front());
+	ret.removeMember("name");
+	ret.removeMember("calls");
+	ret.removeMember("microseconds");
+	ret["counters"] = Json::objectValue;
+	for (auto const& counter: m_counters)
+		ret["counters"][counter.first] = Json::UInt64(counter.second);
+	ret["peakMemory"] = Json::UInt64(peakMemoryUsage());
+	return ret;
+}
+
+string Profiler::toString() const
+{
+	string ret = (boost::format("%-56s %8s %12s\n") % "Phase" % "Calls" % "Time (ms)").str();
+	for (size_t child: m_phases.front().children)
+		toString(ret, m_phases[child], 0);
+	if (!m_counters.empty())
+	{
+		ret += (boost::format("\n%-56s %21s\n") % "Counter" % "Value").str();
+		for (auto const& counter: m_counters)
+			ret += (boost::format("%-56s %21d\n") % counter.first % counter.second).str();
+	}
+	if (uint64_t memory = peakMemoryUsage())
+		ret += (boost::format("\nPeak memory usage: %.1f MiB\n") % (double(memory) / (1024 * 1024))).str();
+	return ret;
+}
+
+uint64_t Profiler::peakMemoryUsage()
+{
+#if defined(__linux__) || defined(__APPLE__)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return uint64_t(usage.ru_maxrss);
+#else
+	// Linux reports kilobytes.
+	return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+Json::Value Profiler::toJson(Phase const& _phase) const
+{
+	Json::Value ret(Json::objectValue);
+	ret["name"] = _phase.name;
+	ret["calls"] = Json::UInt64(_phase.calls);
+	ret["microseconds"] = Json::Int64(chrono::duration_cast<chrono::microseconds>(_phase.total).count());
+	ret["phases"] = Json::arrayValue;
+	for (size_t child: _phase.children)
+		ret["phases"].append(toJson(m_phases[child]));
+	return ret;
+}
+
+void Profiler::toString(string& _output, Phase const& _phase, size_t _depth) const
+{
+	_output += (boost::format("%-56s %8d %12.3f\n") %
+		(string(2 * _depth, ' ') + _phase.name) %
+		_phase.calls %
+		(double(chrono::duration_cast<chrono::microseconds>(_phase.total).count()) / 1000)
+	).str();
+	for (size_t child: _phase.children)
+		toString(_output, m_phases[child], _depth + 1);
+}
@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Timing and memory instrumentation of compiler phases.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Collects the wall-clock time spent in nested, named phases, named event counters
+ * and the peak memory usage of the process.
+ *
+ * There is a single global instance, which is disabled by default. While disabled,
+ * ScopedTimer and count() only test a flag, so instrumentation can stay in place
+ * permanently.
+ */
+class Profiler
+{
+public:
+	static Profiler& instance();
+
+	void enable(bool _enabled = true) { m_enabled = _enabled; }
+	bool enabled() const { return m_enabled; }
+	/// Discards all measurements. Must not be called while a phase is running.
+	void reset();
+
+	/// Starts a phase nested in the currently running phase. Phases with the same name
+	/// and the same parent are accumulated.
+	void start(std::string const& _name);
+	/// Stops the innermost running phase.
+	void stop();
+
+	/// Adds @a _amount to the counter @a _name.
+	void count(char const* _name, uint64_t _amount = 1)
+	{
+		if (m_enabled)
+			m_counters[_name] += _amount;
+	}
+
+	/// @returns the measurements as
+	/// {"phases": [{"name", "calls", "microseconds", "phases"}, ...], "counters": {...}, "peakMemory": bytes}
+	Json::Value toJson() const;
+	/// @returns the measurements as an indented table.
+	std::string toString() const;
+
+	/// @returns the peak resident set size of the process in bytes or zero if unavailable.
+	static uint64_t peakMemoryUsage();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Phase
+	{
+		std::string name;
+		size_t parent = 0;
+		std::vector<size_t> children;
+		size_t calls = 0;
+		Clock::duration total{};
+		Clock::time_point start;
+	};
+
+	Profiler() { reset(); }
+
+	Json::Value toJson(Phase const& _phase) const;
+	void toString(std::string& _output, Phase const& _phase, size_t _depth) const;
+
+	bool m_enabled = false;
+	/// All phases in creation order. The first entry is the root.
+	std::vector<Phase> m_phases;
+	/// Index of the innermost running phase.
+	size_t m_current = 0;
+	std::map<std::string, uint64_t> m_counters;
+};
+
+/**
+ * Measures the time until the end of the scope as a phase of the global profiler.
+ */
+class ScopedTimer
+{
+public:
+	explicit ScopedTimer(char const* _name): m_active(Profiler::instance().enabled())
+	{
+		if (m_active)
+			Profiler::instance().start(_name);
+	}
+	explicit ScopedTimer(std::string const& _name): m_active(Profiler::instance().enabled())
+	{
+		if (m_active)
+			Profiler::instance().start(_name);
+	}
+	~ScopedTimer()
+	{
+		if (m_active)
+			Profiler::instance().stop();
+	}
+
+	ScopedTimer(ScopedTimer const&) = delete;
+	ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+private:
+	bool m_active;
+};
+
+}
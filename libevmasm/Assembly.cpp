@@ -28,6 +28,9 @@
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/Inliner.h>
+
+#include <libdevcore/Profiler.h>
 
 #include <fstream>
 #include <json/json.h>
@@ -371,6 +374,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 	settings.runPeephole = true;
 	if (_enable)
 	{
+		settings.runInliner = true;
 		settings.runDeduplicate = true;
 		settings.runCSE = true;
 		settings.runConstantOptimiser = true;
@@ -384,6 +388,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	ScopedTimer timer("evmasm optimiser");
 	optimiseInternal(_settings, {});
 	return *this;
 }
@@ -412,9 +417,27 @@ map<u256, u256> Assembly::optimiseInternal(
 	for (unsigned count = 1; count > 0;)
 	{
 		count = 0;
+		Profiler::instance().count("evmasm optimiser iterations");
+
+		// Function bodies only become inlinable once the other steps removed the jumps
+		// to their return tags, so this is repeated in every iteration.
+		if (_settings.runInliner)
+		{
+			ScopedTimer timer("Inliner");
+			Inliner inliner{
+				m_items,
+				_tagsReferencedFromOutside,
+				_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
+				_settings.isCreation,
+				_settings.evmVersion
+			};
+			if (inliner.optimise())
+				count++;
+		}
 
 		if (_settings.runJumpdestRemover)
 		{
+			ScopedTimer timer("JumpdestRemover");
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -422,6 +445,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
+			ScopedTimer timer("PeepholeOptimiser");
 			PeepholeOptimiser peepOpt{m_items};
 			while (peepOpt.optimise())
 			{
@@ -433,6 +457,7 @@ map<u256, u256> Assembly::optimiseInternal(
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			ScopedTimer timer("BlockDeduplicator");
 			BlockDeduplicator dedup{m_items};
 			if (dedup.deduplicate())
 			{
@@ -461,15 +486,27 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			// We only use the control flow graph to determine constant storage and memory
+			// contents at the start of blocks, which treats such tags conservatively.
+			ScopedTimer timer("CommonSubexpressionEliminator");
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
+			map<unsigned, KnownStatePointer> knowledgeAtBlockStarts =
+				ControlFlowGraph(m_items).knowledgeAtBlockStarts(_tagsReferencedFromOutside, !usesMSize);
+
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
+				auto knowledge = knowledgeAtBlockStarts.find(unsigned(iter - m_items.begin()));
+				KnownState initialState;
+				if (knowledge != knowledgeAtBlockStarts.end())
+				{
+					initialState = *knowledge->second;
+					Profiler::instance().count("evmasm CSE blocks with known storage or memory");
+				}
+				CommonSubexpressionEliminator eliminator{initialState};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
 				bool shouldReplace = false;
@@ -490,6 +527,42 @@ map<u256, u256> Assembly::optimiseInternal(
 					// reorganise the expression tree, but not all leaves are available.
 				}
 
+				if (shouldReplace && !initialState.stackElements().empty())
+				{
+					// Constant stack elements can turn e.g. a keccak256 into a large constant,
+					// which is not always cheaper given the number of runs, so compare with
+					// the result without stack knowledge.
+					KnownState stateWithoutStack = initialState;
+					stateWithoutStack.resetStack();
+					CommonSubexpressionEliminator alternativeEliminator{stateWithoutStack};
+					alternativeEliminator.feedItems(orig, m_items.end(), usesMSize);
+					try
+					{
+						AssemblyItems alternativeChunk = alternativeEliminator.getOptimizedItems();
+						auto gasNeeded = [&](AssemblyItems const& _chunk) {
+							return ConstantOptimisationMethod::gasNeeded(
+								_chunk,
+								_settings.isCreation,
+								_settings.expectedExecutionsPerDeployment,
+								_settings.evmVersion
+							);
+						};
+						if (alternativeChunk != optimisedChunk && gasNeeded(alternativeChunk) < gasNeeded(optimisedChunk))
+						{
+							optimisedChunk = move(alternativeChunk);
+							shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
+						}
+					}
+					catch (StackTooDeepException const&)
+					{
+						// Keep the code that uses the stack knowledge.
+					}
+					catch (ItemNotAvailableException const&)
+					{
+						// Keep the code that uses the stack knowledge.
+					}
+				}
+
 				if (shouldReplace)
 				{
 					count++;
@@ -507,12 +580,16 @@ map<u256, u256> Assembly::optimiseInternal(
 	}
 
 	if (_settings.runConstantOptimiser)
+	{
+		ScopedTimer timer("ConstantOptimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
-			*this
+			*this,
+			_settings.isCreation ? nullptr : _settings.executionProfile.get()
 		);
+	}
 
 	return tagReplacements;
 }
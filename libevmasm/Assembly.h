@@ -20,6 +20,7 @@
 #include <libevmasm/Instruction.h>
 #include <liblangutil/SourceLocation.h>
 #include <libevmasm/AssemblyItem.h>
+#include <libevmasm/ExecutionProfile.h>
 #include <libevmasm/LinkerObject.h>
 #include <libevmasm/Exceptions.h>
 
@@ -102,6 +103,7 @@ public:
 	struct OptimiserSettings
 	{
 		bool isCreation = false;
+		bool runInliner = false;
 		bool runJumpdestRemover = false;
 		bool runPeephole = false;
 		bool runDeduplicate = false;
@@ -111,6 +113,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Execution counts that override @a expectedExecutionsPerDeployment for the code
+		/// they cover, if available.
+		std::shared_ptr<ExecutionProfile const> executionProfile;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
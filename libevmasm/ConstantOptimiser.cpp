@@ -21,6 +21,7 @@
 
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ExecutionProfile.h>
 #include <libevmasm/GasMeter.h>
 using namespace std;
 using namespace dev;
@@ -30,7 +31,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	langutil::EVMVersion _evmVersion,
-	Assembly& _assembly
+	Assembly& _assembly,
+	ExecutionProfile const* _profile
 )
 {
 	// TODO: design the optimiser in a way this is not needed
@@ -38,9 +40,17 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 
 	unsigned optimisations = 0;
 	map<AssemblyItem, size_t> pushes;
+	// Sum of the expected executions of all occurrences of each constant.
+	map<AssemblyItem, bigint> executions;
 	for (AssemblyItem const& item: _items)
 		if (item.type() == Push)
+		{
 			pushes[item]++;
+			boost::optional<size_t> count;
+			if (_profile)
+				count = _profile->locationCount(item.location());
+			executions[item] += count ? *count : _runs;
+		}
 	map<u256, AssemblyItems> pendingReplacements;
 	for (auto it: pushes)
 	{
@@ -50,7 +60,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		Params params;
 		params.multiplicity = it.second;
 		params.isCreation = _isCreation;
-		params.runs = _runs;
+		// The runs are per opcode, so use the average over all occurrences.
+		params.runs = size_t((executions[item] + it.second - 1) / it.second);
 		params.evmVersion = _evmVersion;
 		LiteralMethod lit(params, item.data());
 		bigint literalGas = lit.gasNeeded();
@@ -77,6 +88,44 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	return optimisations;
 }
 
+bigint ConstantOptimisationMethod::gasNeeded(
+	AssemblyItems const& _items,
+	bool _isCreation,
+	size_t _runs,
+	langutil::EVMVersion _evmVersion
+)
+{
+	bigint gas = 0;
+	AssemblyItems otherItems;
+	for (AssemblyItem const& item: _items)
+		if (item.type() == Push && item.data() >= 0x100)
+		{
+			Params params;
+			params.multiplicity = 1;
+			params.isCreation = _isCreation;
+			params.runs = _runs;
+			params.evmVersion = _evmVersion;
+			gas += min(
+				LiteralMethod(params, item.data()).gasNeeded(),
+				min(CodeCopyMethod(params, item.data()).gasNeeded(), ComputeMethod(params, item.data()).gasNeeded())
+			);
+		}
+		else
+			otherItems.push_back(item);
+
+	bigint runGas = 0;
+	for (AssemblyItem const& item: otherItems)
+		if (item.type() != Operation)
+			runGas += GasMeter::runGas(Instruction::PUSH1);
+		else if (item.instruction() == Instruction::KECCAK256)
+			runGas += GasCosts::keccak256Gas + GasCosts::keccak256WordGas;
+		else if (item.instruction() == Instruction::EXP)
+			runGas += GasCosts::expGas;
+		else if (instructionInfo(item.instruction()).gasPriceTier != Tier::Special)
+			runGas += GasMeter::runGas(item.instruction());
+	return gas + _runs * runGas + GasMeter::dataGas(bytesRequired(otherItems), _isCreation);
+}
+
 bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items)
 {
 	bigint gas = 0;
@@ -39,6 +39,7 @@ namespace eth
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
+class ExecutionProfile;
 
 /**
  * Abstract base class for one way to change how constants are represented in the code.
@@ -48,12 +49,25 @@ class ConstantOptimisationMethod
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
 	/// @a _assembly.
+	/// If @a _profile is given, the occurrences of constants it covers are assumed to be
+	/// executed as often as profiled instead of @a _runs times.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		langutil::EVMVersion _evmVersion,
-		Assembly& _assembly
+		Assembly& _assembly,
+		ExecutionProfile const* _profile = nullptr
+	);
+
+	/// @returns the estimated gas needed to store @a _items and execute them @a _runs times,
+	/// where each constant is represented by the cheapest method.
+	/// Instructions with special gas costs other than KECCAK256 and EXP are not taken into account.
+	static bigint gasNeeded(
+		AssemblyItems const& _items,
+		bool _isCreation,
+		size_t _runs,
+		langutil::EVMVersion _evmVersion
 	);
 
 protected:
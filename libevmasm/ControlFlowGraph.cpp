@@ -34,6 +34,83 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+namespace
+{
+
+/// Contents of storage and memory at constant locations that are known to be constant
+/// and constant stack elements, keyed by their offset from the top (zero for the topmost element).
+struct ConstantStores
+{
+	map<u256, u256> storage;
+	map<u256, u256> memory;
+	map<int, u256> stack;
+};
+
+/// @returns true if the item pushes a tag of a sub-assembly.
+bool isForeignPushTag(AssemblyItem const& _item)
+{
+	return _item.splitForeignPushTag().first != size_t(-1);
+}
+
+/// Removes everything from @a _this which is not in or not equal to the value in @a _other.
+/// @returns true if anything was removed.
+template <class Key>
+bool intersect(map<Key, u256>& _this, map<Key, u256> const& _other)
+{
+	bool changed = false;
+	for (auto it = _this.begin(); it != _this.end();)
+		if (_other.count(it->first) && _other.at(it->first) == it->second)
+			++it;
+		else
+		{
+			it = _this.erase(it);
+			changed = true;
+		}
+	return changed;
+}
+
+/// @returns a state that only knows about the contents in @a _stores.
+KnownStatePointer stateFromConstantStores(ConstantStores const& _stores)
+{
+	KnownStatePointer state = make_shared<KnownState>();
+	for (auto const& slotAndValue: _stores.storage)
+		for (AssemblyItem const& item: AssemblyItems{slotAndValue.second, slotAndValue.first, Instruction::SSTORE})
+			state->feedItem(item, true);
+	for (auto const& slotAndValue: _stores.memory)
+		for (AssemblyItem const& item: AssemblyItems{slotAndValue.second, slotAndValue.first, Instruction::MSTORE})
+			state->feedItem(item, true);
+	state->resetStack();
+	for (auto const& offsetAndValue: _stores.stack)
+		state->setStackElement(-offsetAndValue.first, state->expressionClasses().find(AssemblyItem(offsetAndValue.second)));
+	return state;
+}
+
+/// @returns the constant values at constant locations known in @a _state.
+ConstantStores constantStores(KnownState const& _state, bool _trackMemory)
+{
+	ConstantStores stores;
+	ExpressionClasses& classes = _state.expressionClasses();
+	auto collect = [&](map<ExpressionClasses::Id, ExpressionClasses::Id> const& _content, map<u256, u256>& _target)
+	{
+		for (auto const& slotAndValue: _content)
+		{
+			u256 const* slot = classes.knownConstant(slotAndValue.first);
+			u256 const* value = classes.knownConstant(slotAndValue.second);
+			if (slot && value)
+				_target[*slot] = *value;
+		}
+	};
+	collect(_state.storageContent(), stores.storage);
+	if (_trackMemory)
+		collect(_state.memoryContent(), stores.memory);
+	for (auto const& heightAndClass: _state.stackElements())
+		if (u256 const* value = classes.knownConstant(heightAndClass.second))
+			stores.stack[_state.stackHeight() - heightAndClass.first] = *value;
+	return stores;
+}
+
+}
+
 BlockId::BlockId(u256 const& _id):
 	m_id(unsigned(_id))
 {
@@ -55,11 +132,134 @@ BasicBlocks ControlFlowGraph::optimisedBlocks()
 	return rebuildCode();
 }
 
+map<unsigned, KnownStatePointer> ControlFlowGraph::knowledgeAtBlockStarts(
+	set<size_t> const& _tagsReferencedFromOutside,
+	bool _trackMemory
+)
+{
+	if (m_items.empty())
+		return {};
+
+	findLargestTag();
+	splitBlocks();
+
+	// Tags whose value might end up as the target of a jump we cannot resolve.
+	set<BlockId> escapingTags;
+	for (size_t tag: _tagsReferencedFromOutside)
+		escapingTags.insert(BlockId(u256(tag)));
+	for (size_t index = 0; index < m_items.size(); ++index)
+	{
+		AssemblyItem const& item = m_items.at(index);
+		if (item.type() != PushTag || isForeignPushTag(item))
+			continue;
+		bool jumpedTo =
+			index + 1 < m_items.size() &&
+			(m_items.at(index + 1) == Instruction::JUMP || m_items.at(index + 1) == Instruction::JUMPI);
+		if (!jumpedTo)
+			escapingTags.insert(BlockId(item.data()));
+	}
+
+	auto startsWithTag = [&](BasicBlock const& _block)
+	{
+		return _block.begin < _block.end && m_items.at(_block.begin).type() == Tag;
+	};
+	// Blocks that can only be entered from the predecessors we know.
+	auto inheritsKnowledge = [&](BlockId _id)
+	{
+		return _id != BlockId::initial() && !(startsWithTag(m_blocks.at(_id)) && escapingTags.count(_id));
+	};
+
+	map<unsigned, BlockId> blockByBeginPos;
+	for (auto const& idAndBlock: m_blocks)
+		if (idAndBlock.second.begin != idAndBlock.second.end)
+			blockByBeginPos[idAndBlock.second.begin] = idAndBlock.first;
+
+	map<BlockId, vector<BlockId>> successors;
+	for (auto const& idAndBlock: m_blocks)
+	{
+		BasicBlock const& block = idAndBlock.second;
+		vector<BlockId>& blockSuccessors = successors[idAndBlock.first];
+		if (
+			(block.endType == BasicBlock::EndType::JUMP || block.endType == BasicBlock::EndType::JUMPI) &&
+			block.end - block.begin >= 2
+		)
+		{
+			AssemblyItem const& target = m_items.at(block.end - 2);
+			if (target.type() == PushTag && !isForeignPushTag(target) && m_blocks.count(BlockId(target.data())))
+				blockSuccessors.push_back(BlockId(target.data()));
+		}
+		if (
+			(block.endType == BasicBlock::EndType::JUMPI || block.endType == BasicBlock::EndType::HANDOVER) &&
+			blockByBeginPos.count(block.end)
+		)
+			blockSuccessors.push_back(blockByBeginPos.at(block.end));
+	}
+
+	// Blocks without an entry here are not (yet) known to be reachable.
+	map<BlockId, ConstantStores> entryStores;
+	vector<BlockId> workQueue;
+	for (auto const& idAndBlock: m_blocks)
+		if (!inheritsKnowledge(idAndBlock.first))
+		{
+			entryStores[idAndBlock.first] = ConstantStores{};
+			workQueue.push_back(idAndBlock.first);
+		}
+
+	while (!workQueue.empty())
+	{
+		BlockId id = workQueue.back();
+		workQueue.pop_back();
+		BasicBlock const& block = m_blocks.at(id);
+
+		KnownStatePointer state = stateFromConstantStores(entryStores.at(id));
+		ConstantStores exitStores;
+		bool understood = true;
+		for (unsigned index = block.begin; index < block.end && understood; ++index)
+			if (m_items.at(index).type() == UndefinedItem)
+				understood = false;
+			else
+				state->feedItem(m_items.at(index));
+		if (understood)
+			exitStores = constantStores(*state, _trackMemory);
+
+		for (BlockId successor: successors.at(id))
+		{
+			if (!inheritsKnowledge(successor))
+				continue;
+			auto it = entryStores.find(successor);
+			if (it == entryStores.end())
+				entryStores[successor] = exitStores;
+			else
+			{
+				bool storageChanged = intersect(it->second.storage, exitStores.storage);
+				bool memoryChanged = intersect(it->second.memory, exitStores.memory);
+				bool stackChanged = intersect(it->second.stack, exitStores.stack);
+				if (!storageChanged && !memoryChanged && !stackChanged)
+					continue;
+			}
+			workQueue.push_back(successor);
+		}
+	}
+
+	map<unsigned, KnownStatePointer> knowledge;
+	for (auto const& idAndStores: entryStores)
+	{
+		ConstantStores const& stores = idAndStores.second;
+		if (stores.storage.empty() && stores.memory.empty() && stores.stack.empty())
+			continue;
+		BasicBlock const& block = m_blocks.at(idAndStores.first);
+		unsigned position = startsWithTag(block) ? block.begin + 1 : block.begin;
+		if (position < block.end)
+			knowledge[position] = stateFromConstantStores(stores);
+	}
+	return knowledge;
+}
+
 void ControlFlowGraph::findLargestTag()
 {
 	m_lastUsedId = 0;
 	for (auto const& item: m_items)
-		if (item.type() == Tag || item.type() == PushTag)
+		if (item.type() == Tag || (item.type() == PushTag && !isForeignPushTag(item)))
 		{
 			// Assert that it can be converted.
 			BlockId(item.data());
@@ -86,7 +286,7 @@ void ControlFlowGraph::splitBlocks()
 			id = item.type() == Tag ? BlockId(item.data()) : generateNewId();
 			m_blocks[id].begin = index;
 		}
-		if (item.type() == PushTag)
+		if (item.type() == PushTag && !isForeignPushTag(item))
 			m_blocks[id].pushedTags.emplace_back(item.data());
 		if (SemanticInformation::altersControlFlow(item))
 		{
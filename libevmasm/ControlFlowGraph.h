@@ -23,8 +23,10 @@
 
 #pragma once
 
-#include <vector>
+#include <map>
 #include <memory>
+#include <set>
+#include <vector>
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
 #include <libevmasm/ExpressionClasses.h>
@@ -108,6 +110,23 @@ public:
 	/// Should be called only once.
 	BasicBlocks optimisedBlocks();
 
+	/// Determines the contents of storage, memory and the stack that are known at the start of each basic
+	/// block by intersecting the knowledge at the end of all its predecessors. Does not modify
+	/// the code and, unlike @a optimisedBlocks, does not assume that only pushed tags are jumped to:
+	/// A block starting with a tag only inherits knowledge if the tag is not in
+	/// @a _tagsReferencedFromOutside and every push of the tag is directly followed by a jump.
+	/// Any other tag (e.g. a return address or a function stored in storage) might be the target
+	/// of a jump to an unknown location and such blocks start without any knowledge.
+	/// Only constant values at constant locations or stack positions are retained, memory only
+	/// if @a _trackMemory is set.
+	/// Should be called only once.
+	/// @returns a map from the index of the first item after the initial tag of a block to the
+	/// knowledge at that point, only for blocks where something is known.
+	std::map<unsigned, KnownStatePointer> knowledgeAtBlockStarts(
+		std::set<size_t> const& _tagsReferencedFromOutside,
+		bool _trackMemory
+	);
+
 private:
 	void findLargestTag();
 	void splitBlocks();
@@ -0,0 +1,169 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Execution counts of code collected from traces, used to guide the optimiser.
+ */
+
+#include <libevmasm/ExecutionProfile.h>
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+boost::optional<size_t> parseCount(Json::Value const& _value)
+{
+	if (!_value.isUInt64() || _value.asUInt64() > numeric_limits<size_t>::max())
+		return boost::none;
+	return size_t(_value.asUInt64());
+}
+
+boost::optional<int> parseOffset(string const& _text)
+{
+	if (_text.empty() || _text.size() > 9 || !all_of(_text.begin(), _text.end(), ::isdigit))
+		return boost::none;
+	return stoi(_text);
+}
+
+}
+
+boost::variant<ExecutionProfile, string> ExecutionProfile::fromJson(Json::Value const& _json)
+{
+	if (!_json.isObject())
+		return string("The execution profile must be an object.");
+	for (auto const& member: _json.getMemberNames())
+		if (member != "functions" && member != "locations")
+			return "Unknown key in execution profile: \"" + member + "\"";
+
+	ExecutionProfile profile;
+	if (_json.isMember("functions"))
+	{
+		Json::Value const& functions = _json["functions"];
+		if (!functions.isObject())
+			return string("\"functions\" in the execution profile must be an object.");
+		for (auto const& signature: functions.getMemberNames())
+			if (auto count = parseCount(functions[signature]))
+				profile.setFunctionCount(signature, *count);
+			else
+				return "Invalid execution count for function \"" + signature + "\".";
+	}
+	if (_json.isMember("locations"))
+	{
+		Json::Value const& locations = _json["locations"];
+		if (!locations.isObject())
+			return string("\"locations\" in the execution profile must be an object.");
+		for (auto const& sourceName: locations.getMemberNames())
+		{
+			Json::Value const& ranges = locations[sourceName];
+			if (!ranges.isObject())
+				return "Execution counts for source \"" + sourceName + "\" must be an object.";
+			for (auto const& range: ranges.getMemberNames())
+			{
+				size_t colon = range.find(':');
+				boost::optional<int> start;
+				boost::optional<int> length;
+				if (colon != string::npos)
+				{
+					start = parseOffset(range.substr(0, colon));
+					length = parseOffset(range.substr(colon + 1));
+				}
+				if (!start || !length)
+					return "Invalid source range \"" + range + "\" in execution profile, expected \"<start>:<length>\".";
+				if (auto count = parseCount(ranges[range]))
+					profile.setLocationCount(sourceName, *start, *length, *count);
+				else
+					return "Invalid execution count for source range \"" + range + "\".";
+			}
+		}
+	}
+	return profile;
+}
+
+Json::Value ExecutionProfile::toJson() const
+{
+	Json::Value json(Json::objectValue);
+	if (!m_functionCounts.empty())
+	{
+		json["functions"] = Json::objectValue;
+		for (auto const& function: m_functionCounts)
+			json["functions"][function.first] = Json::Value(Json::LargestUInt(function.second));
+	}
+	if (!m_locationCounts.empty())
+	{
+		json["locations"] = Json::objectValue;
+		for (auto const& source: m_locationCounts)
+			for (auto const& range: source.second)
+				json["locations"][source.first][to_string(range.first.first) + ":" + to_string(range.first.second)] =
+					Json::Value(Json::LargestUInt(range.second));
+	}
+	return json;
+}
+
+void ExecutionProfile::setLocationCount(string const& _sourceName, int _start, int _length, size_t _count)
+{
+	m_locationCounts[_sourceName][make_pair(_start, _length)] = _count;
+}
+
+boost::optional<size_t> ExecutionProfile::functionCount(string const& _signature) const
+{
+	auto it = m_functionCounts.find(_signature);
+	if (it == m_functionCounts.end())
+		return boost::none;
+	return it->second;
+}
+
+boost::optional<size_t> ExecutionProfile::locationCount(langutil::SourceLocation const& _location) const
+{
+	if (_location.isEmpty() || !_location.source)
+		return boost::none;
+	auto source = m_locationCounts.find(_location.source->name());
+	if (source == m_locationCounts.end())
+		return boost::none;
+
+	boost::optional<size_t> count;
+	int smallestLength = -1;
+	// Ranges are sorted by their start, so no range after the start of the location can contain it.
+	for (auto const& range: source->second)
+	{
+		int start = range.first.first;
+		int length = range.first.second;
+		if (start > _location.start)
+			break;
+		if (_location.end <= start + length && (!count || length < smallestLength))
+		{
+			count = range.second;
+			smallestLength = length;
+		}
+	}
+	return count;
+}
+
+bool ExecutionProfile::hasLocation(langutil::SourceLocation const& _location) const
+{
+	if (_location.isEmpty() || !_location.source)
+		return false;
+	auto source = m_locationCounts.find(_location.source->name());
+	return
+		source != m_locationCounts.end() &&
+		source->second.count(make_pair(_location.start, _location.end - _location.start));
+}
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Execution counts of code collected from traces, used to guide the optimiser.
+ */
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+
+#include <json/json.h>
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace dev
+{
+namespace eth
+{
+
+/**
+ * Execution counts of parts of the code, e.g. collected on a test node or by replaying
+ * transactions. Counts are given per external function, identified by its signature,
+ * and per source range, identified by the source name, start offset and length as in
+ * source mappings.
+ *
+ * Code covered by a profiled range is optimised for the number of executions of the
+ * smallest such range instead of the global estimate, i.e. frequently executed code
+ * is optimised for runtime gas and code that is never executed for size.
+ */
+class ExecutionProfile
+{
+public:
+	/// Parses a profile of the form
+	/// {"functions": {"<signature>": <count>, ...}, "locations": {"<source>": {"<start>:<length>": <count>, ...}, ...}}
+	/// @returns the profile or an error message.
+	static boost::variant<ExecutionProfile, std::string> fromJson(Json::Value const& _json);
+	/// @returns the profile in the format accepted by @a fromJson.
+	Json::Value toJson() const;
+
+	void setFunctionCount(std::string const& _signature, size_t _count) { m_functionCounts[_signature] = _count; }
+	void setLocationCount(std::string const& _sourceName, int _start, int _length, size_t _count);
+
+	/// @returns the number of calls of the external function with the given signature, if profiled.
+	boost::optional<size_t> functionCount(std::string const& _signature) const;
+	/// @returns the number of executions of the smallest profiled range containing @a _location, if any.
+	boost::optional<size_t> locationCount(langutil::SourceLocation const& _location) const;
+	/// @returns true if the exact range of @a _location is profiled.
+	bool hasLocation(langutil::SourceLocation const& _location) const;
+
+	std::map<std::string, size_t> const& functionCounts() const { return m_functionCounts; }
+	bool empty() const { return m_functionCounts.empty() && m_locationCounts.empty(); }
+
+	bool operator==(ExecutionProfile const& _other) const
+	{
+		return m_functionCounts == _other.m_functionCounts && m_locationCounts == _other.m_locationCounts;
+	}
+
+private:
+	std::map<std::string, size_t> m_functionCounts;
+	/// Execution counts by source name and range given as start and length.
+	std::map<std::string, std::map<std::pair<int, int>, size_t>> m_locationCounts;
+};
+
+}
+}
@@ -260,6 +260,11 @@ unsigned GasMeter::runGas(Instruction _instruction)
 	return 0;
 }
 
+bigint GasMeter::dataGas(bigint const& _length, bool _inCreation)
+{
+	return _length * (_inCreation ? GasCosts::txDataNonZeroGas : GasCosts::createDataGas);
+}
+
 u256 GasMeter::dataGas(bytes const& _data, bool _inCreation)
 {
 	bigint gas = 0;
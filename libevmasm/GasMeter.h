@@ -140,6 +140,9 @@ public:
 	/// In case of @a _inCreation, the data is only sent as a transaction and is not stored, whereas
 	/// otherwise code will be stored and have to pay "createDataGas" cost.
 	static u256 dataGas(bytes const& _data, bool _inCreation);
+	/// @returns the gas cost of @a _length bytes of data like above, assuming that none of
+	/// the bytes is zero.
+	static bigint dataGas(bigint const& _length, bool _inCreation);
 
 private:
 	/// @returns _multiplier * (_value + 31) / 32, if _value is a known constant and infinite otherwise.
@@ -0,0 +1,180 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Inlines small internal functions at their call sites.
+ */
+
+#include <libevmasm/Inliner.h>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libdevcore/Profiler.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+/// @returns true if @a _item pushes a tag of the current assembly.
+bool isLocalPushTag(AssemblyItem const& _item)
+{
+	return _item.type() == PushTag && _item.splitForeignPushTag().first == size_t(-1);
+}
+
+}
+
+bool Inliner::optimise()
+{
+	map<size_t, InlinableBlock> inlinableBlocks = determineInlinableBlocks();
+	if (inlinableBlocks.empty())
+		return false;
+
+	// Decide once per function, so that either all or none of its calls are inlined.
+	set<size_t> tagsToInline;
+	for (auto const& tagAndBlock: inlinableBlocks)
+		if (shouldInline(tagAndBlock.first, tagAndBlock.second))
+			tagsToInline.insert(tagAndBlock.first);
+	if (tagsToInline.empty())
+		return false;
+
+	bool changed = false;
+	AssemblyItems newItems;
+	for (size_t index = 0; index < m_items.size(); ++index)
+	{
+		AssemblyItem const& item = m_items[index];
+		if (
+			isLocalPushTag(item) &&
+			index + 1 < m_items.size() &&
+			m_items[index + 1] == Instruction::JUMP &&
+			m_items[index + 1].getJumpType() == AssemblyItem::JumpType::IntoFunction &&
+			tagsToInline.count(size_t(item.data()))
+		)
+		{
+			AssemblyItems const& body = inlinableBlocks.at(size_t(item.data())).items;
+			newItems.insert(newItems.end(), body.begin(), prev(body.end()));
+			// The jump out of the function now only jumps to the return address.
+			newItems.emplace_back(Instruction::JUMP, body.back().location());
+			Profiler::instance().count("evmasm inlined function calls");
+			changed = true;
+			// Skip the jump into the function.
+			++index;
+		}
+		else
+			newItems.push_back(item);
+	}
+	m_items = move(newItems);
+	return changed;
+}
+
+map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks() const
+{
+	map<size_t, InlinableBlock> inlinableBlocks;
+	map<size_t, size_t> pushTagCounts;
+	// Index of the tag that started the current block, if the block has straight control flow so far.
+	size_t lastTag = size_t(-1);
+	for (size_t index = 0; index < m_items.size(); ++index)
+	{
+		AssemblyItem const& item = m_items[index];
+		// The number of pushes approximates the number of calls to a function.
+		if (isLocalPushTag(item))
+			pushTagCounts[size_t(item.data())]++;
+
+		// We can only inline blocks with straight control flow. Using breaksCSEAnalysisBlock
+		// allows the jump to the return address to be resolved after inlining.
+		if (lastTag != size_t(-1) && SemanticInformation::breaksCSEAnalysisBlock(item, false))
+		{
+			if (item == Instruction::JUMP && item.getJumpType() == AssemblyItem::JumpType::OutOfFunction)
+			{
+				size_t tag = size_t(m_items[lastTag].data());
+				AssemblyItems body(m_items.begin() + lastTag + 1, m_items.begin() + index + 1);
+				// Never inline functions that reference themselves.
+				bool selfReferencing = false;
+				for (AssemblyItem const& bodyItem: body)
+					if (isLocalPushTag(bodyItem) && size_t(bodyItem.data()) == tag)
+						selfReferencing = true;
+				if (!selfReferencing)
+					inlinableBlocks[tag].items = move(body);
+			}
+			lastTag = size_t(-1);
+		}
+
+		if (item.type() == Tag)
+			lastTag = index;
+	}
+
+	// Blocks whose tags are never pushed are never called.
+	for (auto it = inlinableBlocks.begin(); it != inlinableBlocks.end();)
+		if (pushTagCounts.count(it->first))
+		{
+			it->second.pushTagCount = pushTagCounts.at(it->first);
+			++it;
+		}
+		else
+			it = inlinableBlocks.erase(it);
+	return inlinableBlocks;
+}
+
+bool Inliner::shouldInline(size_t _tag, InlinableBlock const& _block) const
+{
+	// Size of the function body in bytes (without the jump out of the function).
+	bigint bodySize = bytesRequired(AssemblyItems(_block.items.begin(), prev(_block.items.end())), 2);
+
+	// The number of pushes of the tag approximates both the number of call sites and the
+	// number of calls per run.
+	size_t numberOfCalls = _block.pushTagCount;
+
+	static AssemblyItems const callSitePattern{
+		AssemblyItem{PushTag},
+		AssemblyItem{PushTag},
+		AssemblyItem{Instruction::JUMP},
+		AssemblyItem{Tag}
+	};
+	static AssemblyItems const functionPattern{
+		AssemblyItem{Tag},
+		// The function body is accounted for separately.
+		AssemblyItem{Instruction::JUMP}
+	};
+
+	// Both patterns are executed for every call.
+	bigint callCost = numberOfCalls * bigint(executionCost(callSitePattern) + executionCost(functionPattern));
+	// Every call site stores the call site pattern, the function is only stored once.
+	bigint callDepositCost = GasMeter::dataGas(
+		numberOfCalls * bytesRequired(callSitePattern, 2) + bytesRequired(functionPattern, 2) + bodySize,
+		m_isCreation
+	);
+	// When inlining, every call site stores a copy of the body instead.
+	bigint inlinedDepositCost = GasMeter::dataGas(numberOfCalls * bodySize, m_isCreation);
+	// Functions referenced from outside this assembly can never be removed.
+	if (m_tagsReferencedFromOutside.count(_tag))
+		inlinedDepositCost += GasMeter::dataGas(bytesRequired(functionPattern, 2) + bodySize, m_isCreation);
+
+	return bigint(m_runs) * callCost + callDepositCost > inlinedDepositCost;
+}
+
+u256 Inliner::executionCost(AssemblyItems const& _items) const
+{
+	GasMeter meter(make_shared<KnownState>(), m_evmVersion);
+	GasMeter::GasConsumption cost;
+	for (AssemblyItem const& item: _items)
+		cost += meter.estimateMax(item, false);
+	assertThrow(!cost.isInfinite, OptimizerException, "Infinite gas cost for jump pattern.");
+	return cost.value;
+}
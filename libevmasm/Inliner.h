@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Inlines small internal functions at their call sites.
+ */
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libdevcore/Common.h>
+
+#include <cstddef>
+#include <map>
+#include <set>
+
+namespace dev
+{
+namespace eth
+{
+
+/**
+ * Replaces calls to internal functions (``PUSH tag JUMP`` with the jump marked as going into
+ * a function) by a copy of the function body, if the body consists of a single block that
+ * ends in a jump out of the function and inlining is cheaper according to the expected number
+ * of executions. The jump out of the function is kept but turned into an ordinary jump to the
+ * return address, which is usually resolved and removed by the other optimiser steps, together
+ * with the function itself if it is not referenced anymore.
+ */
+class Inliner
+{
+public:
+	explicit Inliner(
+		AssemblyItems& _items,
+		std::set<size_t> const& _tagsReferencedFromOutside,
+		size_t _runs,
+		bool _isCreation,
+		langutil::EVMVersion _evmVersion
+	):
+		m_items(_items),
+		m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
+		m_runs(_runs),
+		m_isCreation(_isCreation),
+		m_evmVersion(_evmVersion)
+	{}
+
+	/// @returns true if any function call was inlined.
+	bool optimise();
+
+private:
+	/// Function body that can be inlined together with the number of times its tag is pushed.
+	struct InlinableBlock
+	{
+		/// The items after the tag, including the final jump.
+		AssemblyItems items;
+		size_t pushTagCount = 0;
+	};
+
+	/// @returns the blocks that start with a tag, contain no further control flow and end
+	/// in a jump out of a function, indexed by their tag.
+	std::map<size_t, InlinableBlock> determineInlinableBlocks() const;
+	/// @returns true if inlining the function body @a _block at each of its call sites is
+	/// cheaper than calling it, taking the code deposit and the expected executions into account.
+	bool shouldInline(size_t _tag, InlinableBlock const& _block) const;
+
+	/// @returns an estimation of the runtime gas cost of the items in @a _items.
+	u256 executionCost(AssemblyItems const& _items) const;
+
+	AssemblyItems& m_items;
+	std::set<size_t> const& m_tagsReferencedFromOutside;
+	size_t const m_runs;
+	bool const m_isCreation;
+	langutil::EVMVersion const m_evmVersion;
+};
+
+}
+}
@@ -143,6 +143,14 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 					loadFromMemory(arguments[0], _item.location())
 				);
 				break;
+			case Instruction::CALLDATACOPY:
+			case Instruction::CODECOPY:
+			case Instruction::RETURNDATACOPY:
+				copyToMemory(arguments[0], arguments[2]);
+				break;
+			case Instruction::EXTCODECOPY:
+				copyToMemory(arguments[1], arguments[3]);
+				break;
 			case Instruction::KECCAK256:
 				setStackElement(
 					m_stackHeight + _item.deposit(),
@@ -353,6 +361,26 @@ ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const&
 	return m_memoryContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
+void KnownState::copyToMemory(Id _start, Id _length)
+{
+	m_sequenceNumber += 2;
+	u256 const* length = m_expressionClasses->knownConstant(_length);
+	if (length && *length == 0)
+		return;
+	decltype(m_memoryContent) memoryContents;
+	// copy over values at points where we know that they are outside of [_start - 31, _start + _length)
+	if (length)
+		for (auto const& memoryItem: m_memoryContent)
+		{
+			u256 const* distance = m_expressionClasses->knownConstant(
+				m_expressionClasses->find(Instruction::SUB, {memoryItem.first, _start})
+			);
+			if (distance && *distance >= *length && *distance <= u256(0) - 32)
+				memoryContents.insert(memoryItem);
+		}
+	m_memoryContent = move(memoryContents);
+}
+
 KnownState::Id KnownState::applyKeccak256(
 	Id _start,
 	Id _length,
@@ -124,6 +124,9 @@ public:
 	Id stackElement(int _stackHeight, langutil::SourceLocation const& _location);
 	/// @returns the stackElement relative to the current stack height.
 	Id relativeStackElement(int _stackOffset, langutil::SourceLocation const& _location = {});
+	/// Assigns a new equivalence class to the next sequence number of the given stack element.
+	/// Can be used to provide knowledge about the initial stack.
+	void setStackElement(int _stackHeight, Id _class);
 
 	/// @returns its set of tags if the given expression class is a known tag union; returns a set
 	/// containing the tag if it is a PushTag expression and the empty set otherwise.
@@ -137,10 +140,9 @@ public:
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
 	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& memoryContent() const { return m_memoryContent; }
 
 private:
-	/// Assigns a new equivalence class to the next sequence number of the given stack element.
-	void setStackElement(int _stackHeight, Id _class);
 	/// Swaps the given stack elements in their next sequence number.
 	void swapStackElements(int _stackHeightA, int _stackHeightB, langutil::SourceLocation const& _location);
 
@@ -156,6 +158,9 @@ private:
 	StoreOperation storeInMemory(Id _slot, Id _value, langutil::SourceLocation const& _location);
 	/// Retrieves the current value at the given slot in memory or creates a new special mload class.
 	Id loadFromMemory(Id _slot, langutil::SourceLocation const& _location);
+	/// Increments the sequence number and deletes all memory information that might be
+	/// overwritten by copying _length bytes of unknown data to _start.
+	void copyToMemory(Id _start, Id _length);
 	/// Finds or creates a new expression that applies the Keccak-256 hash function to the contents in memory.
 	Id applyKeccak256(Id _start, Id _length, langutil::SourceLocation const& _location);
 
@@ -23,6 +23,7 @@
 
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
+#include <libevmasm/SuperoptimisedRules.h>
 
 using namespace std;
 using namespace dev::eth;
@@ -298,6 +299,42 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 	}
 };
 
+/// Replaces instruction sequences by the cheaper equivalent sequences found by the superoptimiser.
+struct Superoptimised
+{
+	static bool apply(OptimiserState& _state)
+	{
+		static map<Instruction, vector<SuperoptimisedRule const*>> const rulesByFirstInstruction = []()
+		{
+			map<Instruction, vector<SuperoptimisedRule const*>> rules;
+			for (SuperoptimisedRule const& rule: superoptimisedRules())
+				rules[rule.pattern.front()].push_back(&rule);
+			return rules;
+		}();
+
+		AssemblyItem const& first = _state.items[_state.i];
+		if (first.type() != Operation || !rulesByFirstInstruction.count(first.instruction()))
+			return false;
+		for (SuperoptimisedRule const* rule: rulesByFirstInstruction.at(first.instruction()))
+		{
+			if (_state.i + rule->pattern.size() > _state.items.size())
+				continue;
+			if (!equal(
+				rule->pattern.begin(),
+				rule->pattern.end(),
+				_state.items.begin() + _state.i,
+				[](Instruction _instruction, AssemblyItem const& _item) { return _item == _instruction; }
+			))
+				continue;
+			for (Instruction instruction: rule->replacement)
+				*_state.out = {instruction, first.location()};
+			_state.i += rule->pattern.size();
+			return true;
+		}
+		return false;
+	}
+};
+
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
@@ -358,7 +395,7 @@ bool PeepholeOptimiser::optimise()
 			state,
 			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
 			IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
+			TagConjunctions(), TruthyAnd(), Superoptimised(), Identity()
 		);
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
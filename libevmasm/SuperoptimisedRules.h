@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file SuperoptimisedRules.h
+ * Rules for the peephole optimiser. Generated by test/tools/superoptimiser, do not edit.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+
+/// A sequence of stack operations and a shorter sequence that does not cost more gas
+/// and has the same effect on the stack.
+struct SuperoptimisedRule
+{
+	std::vector<Instruction> pattern;
+	std::vector<Instruction> replacement;
+};
+
+/// @returns the rules, longer patterns first.
+inline std::vector<SuperoptimisedRule> const& superoptimisedRules()
+{
+	static std::vector<SuperoptimisedRule> const rules{
+		// ADD SWAP1 POP POP -> POP POP POP (saves 4 gas)
+		{{Instruction::ADD, Instruction::SWAP1, Instruction::POP, Instruction::POP}, {Instruction::POP, Instruction::POP, Instruction::POP}},
+		// ADD SWAP1 DUP2 SWAP1 -> ADD DUP1 SWAP2 (saves 3 gas)
+		{{Instruction::ADD, Instruction::SWAP1, Instruction::DUP2, Instruction::SWAP1}, {Instruction::ADD, Instruction::DUP1, Instruction::SWAP2}},
+		// OR SWAP1 DUP2 SWAP1 -> OR DUP1 SWAP2 (saves 3 gas)
+		{{Instruction::OR, Instruction::SWAP1, Instruction::DUP2, Instruction::SWAP1}, {Instruction::OR, Instruction::DUP1, Instruction::SWAP2}},
+		// NUMBER SWAP1 SWAP2 ADD -> SWAP1 NUMBER ADD (saves 3 gas)
+		{{Instruction::NUMBER, Instruction::SWAP1, Instruction::SWAP2, Instruction::ADD}, {Instruction::SWAP1, Instruction::NUMBER, Instruction::ADD}},
+		// DUP1 SWAP3 SWAP2 SWAP1 -> SWAP2 SWAP1 DUP3 (saves 3 gas)
+		{{Instruction::DUP1, Instruction::SWAP3, Instruction::SWAP2, Instruction::SWAP1}, {Instruction::SWAP2, Instruction::SWAP1, Instruction::DUP3}},
+		// DUP2 ADD SWAP1 POP -> ADD (saves 8 gas)
+		{{Instruction::DUP2, Instruction::ADD, Instruction::SWAP1, Instruction::POP}, {Instruction::ADD}},
+		// DUP3 SWAP2 DUP5 SWAP1 -> DUP4 DUP4 SWAP3 (saves 3 gas)
+		{{Instruction::DUP3, Instruction::SWAP2, Instruction::DUP5, Instruction::SWAP1}, {Instruction::DUP4, Instruction::DUP4, Instruction::SWAP3}},
+		// SWAP1 DUP2 SWAP1 DUP4 -> DUP1 SWAP2 DUP4 (saves 3 gas)
+		{{Instruction::SWAP1, Instruction::DUP2, Instruction::SWAP1, Instruction::DUP4}, {Instruction::DUP1, Instruction::SWAP2, Instruction::DUP4}},
+		// SWAP1 DUP2 SWAP1 DUP6 -> DUP1 SWAP2 DUP6 (saves 3 gas)
+		{{Instruction::SWAP1, Instruction::DUP2, Instruction::SWAP1, Instruction::DUP6}, {Instruction::DUP1, Instruction::SWAP2, Instruction::DUP6}},
+		// SWAP2 ADD SWAP1 POP -> POP ADD (saves 6 gas)
+		{{Instruction::SWAP2, Instruction::ADD, Instruction::SWAP1, Instruction::POP}, {Instruction::POP, Instruction::ADD}},
+		// SWAP2 POP POP POP -> POP POP POP (saves 3 gas)
+		{{Instruction::SWAP2, Instruction::POP, Instruction::POP, Instruction::POP}, {Instruction::POP, Instruction::POP, Instruction::POP}},
+		// SWAP2 SWAP1 DUP2 SWAP1 -> SWAP2 DUP1 SWAP2 (saves 3 gas)
+		{{Instruction::SWAP2, Instruction::SWAP1, Instruction::DUP2, Instruction::SWAP1}, {Instruction::SWAP2, Instruction::DUP1, Instruction::SWAP2}},
+		// SWAP2 SWAP1 SWAP2 ADD -> SWAP1 SWAP2 ADD (saves 3 gas)
+		{{Instruction::SWAP2, Instruction::SWAP1, Instruction::SWAP2, Instruction::ADD}, {Instruction::SWAP1, Instruction::SWAP2, Instruction::ADD}},
+		// SWAP2 SWAP1 SWAP2 AND -> SWAP1 SWAP2 AND (saves 3 gas)
+		{{Instruction::SWAP2, Instruction::SWAP1, Instruction::SWAP2, Instruction::AND}, {Instruction::SWAP1, Instruction::SWAP2, Instruction::AND}},
+		// SWAP2 SWAP1 SWAP2 OR -> SWAP1 SWAP2 OR (saves 3 gas)
+		{{Instruction::SWAP2, Instruction::SWAP1, Instruction::SWAP2, Instruction::OR}, {Instruction::SWAP1, Instruction::SWAP2, Instruction::OR}},
+		// SWAP3 SWAP1 DUP2 SWAP1 -> SWAP3 DUP1 SWAP2 (saves 3 gas)
+		{{Instruction::SWAP3, Instruction::SWAP1, Instruction::DUP2, Instruction::SWAP1}, {Instruction::SWAP3, Instruction::DUP1, Instruction::SWAP2}},
+		// SWAP3 SWAP1 SWAP3 ADD -> SWAP1 SWAP3 ADD (saves 3 gas)
+		{{Instruction::SWAP3, Instruction::SWAP1, Instruction::SWAP3, Instruction::ADD}, {Instruction::SWAP1, Instruction::SWAP3, Instruction::ADD}},
+		// SWAP3 SWAP1 SWAP3 MUL -> SWAP1 SWAP3 MUL (saves 3 gas)
+		{{Instruction::SWAP3, Instruction::SWAP1, Instruction::SWAP3, Instruction::MUL}, {Instruction::SWAP1, Instruction::SWAP3, Instruction::MUL}},
+		// SWAP3 SWAP1 SWAP3 AND -> SWAP1 SWAP3 AND (saves 3 gas)
+		{{Instruction::SWAP3, Instruction::SWAP1, Instruction::SWAP3, Instruction::AND}, {Instruction::SWAP1, Instruction::SWAP3, Instruction::AND}},
+		// SWAP3 SWAP1 SWAP3 OR -> SWAP1 SWAP3 OR (saves 3 gas)
+		{{Instruction::SWAP3, Instruction::SWAP1, Instruction::SWAP3, Instruction::OR}, {Instruction::SWAP1, Instruction::SWAP3, Instruction::OR}},
+		// SWAP3 SWAP2 DUP3 SWAP1 -> SWAP3 DUP1 SWAP3 (saves 3 gas)
+		{{Instruction::SWAP3, Instruction::SWAP2, Instruction::DUP3, Instruction::SWAP1}, {Instruction::SWAP3, Instruction::DUP1, Instruction::SWAP3}},
+		// SWAP4 SWAP1 SWAP4 AND -> SWAP1 SWAP4 AND (saves 3 gas)
+		{{Instruction::SWAP4, Instruction::SWAP1, Instruction::SWAP4, Instruction::AND}, {Instruction::SWAP1, Instruction::SWAP4, Instruction::AND}},
+		// SWAP4 SWAP1 SWAP4 OR -> SWAP1 SWAP4 OR (saves 3 gas)
+		{{Instruction::SWAP4, Instruction::SWAP1, Instruction::SWAP4, Instruction::OR}, {Instruction::SWAP1, Instruction::SWAP4, Instruction::OR}},
+		// SWAP4 SWAP2 DUP3 SWAP1 -> SWAP4 DUP1 SWAP3 (saves 3 gas)
+		{{Instruction::SWAP4, Instruction::SWAP2, Instruction::DUP3, Instruction::SWAP1}, {Instruction::SWAP4, Instruction::DUP1, Instruction::SWAP3}},
+		// SWAP4 SWAP3 DUP4 SWAP1 -> SWAP4 DUP1 SWAP4 (saves 3 gas)
+		{{Instruction::SWAP4, Instruction::SWAP3, Instruction::DUP4, Instruction::SWAP1}, {Instruction::SWAP4, Instruction::DUP1, Instruction::SWAP4}},
+		// SWAP5 SWAP1 SWAP5 MUL -> SWAP1 SWAP5 MUL (saves 3 gas)
+		{{Instruction::SWAP5, Instruction::SWAP1, Instruction::SWAP5, Instruction::MUL}, {Instruction::SWAP1, Instruction::SWAP5, Instruction::MUL}},
+		// SWAP6 SWAP1 SWAP6 OR -> SWAP1 SWAP6 OR (saves 3 gas)
+		{{Instruction::SWAP6, Instruction::SWAP1, Instruction::SWAP6, Instruction::OR}, {Instruction::SWAP1, Instruction::SWAP6, Instruction::OR}},
+		// SWAP11 SWAP1 SWAP11 ADD -> SWAP1 SWAP11 ADD (saves 3 gas)
+		{{Instruction::SWAP11, Instruction::SWAP1, Instruction::SWAP11, Instruction::ADD}, {Instruction::SWAP1, Instruction::SWAP11, Instruction::ADD}},
+		// SWAP12 SWAP1 SWAP12 ADD -> SWAP1 SWAP12 ADD (saves 3 gas)
+		{{Instruction::SWAP12, Instruction::SWAP1, Instruction::SWAP12, Instruction::ADD}, {Instruction::SWAP1, Instruction::SWAP12, Instruction::ADD}},
+		// ISZERO ISZERO ISZERO -> ISZERO (saves 6 gas)
+		{{Instruction::ISZERO, Instruction::ISZERO, Instruction::ISZERO}, {Instruction::ISZERO}},
+		// CALLDATASIZE DUP4 SWAP1 -> DUP3 CALLDATASIZE (saves 3 gas)
+		{{Instruction::CALLDATASIZE, Instruction::DUP4, Instruction::SWAP1}, {Instruction::DUP3, Instruction::CALLDATASIZE}},
+		// CALLDATASIZE DUP5 SWAP1 -> DUP4 CALLDATASIZE (saves 3 gas)
+		{{Instruction::CALLDATASIZE, Instruction::DUP5, Instruction::SWAP1}, {Instruction::DUP4, Instruction::CALLDATASIZE}},
+		// CALLDATASIZE DUP6 SWAP1 -> DUP5 CALLDATASIZE (saves 3 gas)
+		{{Instruction::CALLDATASIZE, Instruction::DUP6, Instruction::SWAP1}, {Instruction::DUP5, Instruction::CALLDATASIZE}},
+		// DUP3 SWAP1 POP -> POP DUP2 (saves 3 gas)
+		{{Instruction::DUP3, Instruction::SWAP1, Instruction::POP}, {Instruction::POP, Instruction::DUP2}},
+		// DUP8 SWAP1 POP -> POP DUP7 (saves 3 gas)
+		{{Instruction::DUP8, Instruction::SWAP1, Instruction::POP}, {Instruction::POP, Instruction::DUP7}},
+		// SWAP1 POP POP -> POP POP (saves 3 gas)
+		{{Instruction::SWAP1, Instruction::POP, Instruction::POP}, {Instruction::POP, Instruction::POP}},
+	};
+	return rules;
+}
+
+}
+}
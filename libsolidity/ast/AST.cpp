@@ -241,6 +241,35 @@ vector<Declaration const*> const& ContractDefinition::inheritableMembers() const
 	return *m_inheritableMembers;
 }
 
+vector<ContractDefinition::UsingForFunction> const& ContractDefinition::usingForFunctions() const
+{
+	if (!m_usingForFunctions)
+	{
+		m_usingForFunctions.reset(new vector<UsingForFunction>());
+		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
+			for (UsingForDirective const* ufd: contract->usingForDirectives())
+			{
+				TypePointer boundType = nullptr;
+				if (ufd->typeName())
+					boundType = TypeProvider::withLocationIfReference(
+						DataLocation::Storage,
+						ufd->typeName()->annotation().type
+					);
+				auto const& library = dynamic_cast<ContractDefinition const&>(
+					*ufd->libraryName().annotation().referencedDeclaration
+				);
+				for (FunctionDefinition const* function: library.definedFunctions())
+					if (function->isVisibleAsLibraryMember() && !function->parameters().empty())
+						m_usingForFunctions->push_back({
+							boundType,
+							function,
+							FunctionType(*function, false).asCallableFunction(true, true)
+						});
+			}
+	}
+	return *m_usingForFunctions;
+}
+
 TypePointer ContractDefinition::type() const
 {
 	return TypeProvider::typeType(TypeProvider::contract(*this));
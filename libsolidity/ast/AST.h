@@ -405,6 +405,20 @@ public:
 	/// @returns a list of the inheritable members of this contract
 	std::vector<Declaration const*> const& inheritableMembers() const;
 
+	/// A library function made available by a "using for" directive.
+	struct UsingForFunction
+	{
+		/// The type the function is bound to with data location storage, nullptr for "using for *".
+		TypePointer boundType;
+		FunctionDefinition const* function;
+		FunctionTypePointer functionType;
+	};
+	/// @returns the library functions made available by the "using for" directives of this
+	/// contract and its bases in the order of the inheritance linearization.
+	/// Functions without parameters are omitted.
+	/// Should only be called after name and type resolution.
+	std::vector<UsingForFunction> const& usingForFunctions() const;
+
 	/// Returns the constructor or nullptr if no constructor was specified.
 	FunctionDefinition const* constructor() const;
 	/// @returns true iff the constructor of this contract is public (or non-existing).
@@ -432,6 +446,7 @@ private:
 	mutable std::unique_ptr<std::vector<std::pair<FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList;
 	mutable std::unique_ptr<std::vector<EventDefinition const*>> m_interfaceEvents;
 	mutable std::unique_ptr<std::vector<Declaration const*>> m_inheritableMembers;
+	mutable std::unique_ptr<std::vector<UsingForFunction>> m_usingForFunctions;
 };
 
 class InheritanceSpecifier: public ASTNode
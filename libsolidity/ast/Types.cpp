@@ -217,6 +217,7 @@ pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	m_memberIndex.reset();
 }
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
@@ -230,12 +231,25 @@ pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name)
 		m_storageOffsets.reset(new StorageOffsets());
 		m_storageOffsets->computeOffsets(memberTypes);
 	}
-	for (size_t index = 0; index < m_memberTypes.size(); ++index)
-		if (m_memberTypes[index].name == _name)
-			return m_storageOffsets->offset(index);
+	vector<size_t> const& indices = memberIndices(_name);
+	if (!indices.empty())
+		return m_storageOffsets->offset(indices.front());
 	return nullptr;
 }
 
+vector<size_t> const& MemberList::memberIndices(string const& _name) const
+{
+	if (!m_memberIndex)
+	{
+		m_memberIndex.reset(new unordered_map<string, vector<size_t>>());
+		for (size_t index = 0; index < m_memberTypes.size(); ++index)
+			(*m_memberIndex)[m_memberTypes[index].name].push_back(index);
+	}
+	static vector<size_t> const noMembers;
+	auto it = m_memberIndex->find(_name);
+	return it == m_memberIndex->end() ? noMembers : it->second;
+}
+
 u256 const& MemberList::storageSize() const
 {
 	// trigger lazy computation
@@ -361,29 +375,15 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ContractDefinition
 	TypePointer type = TypeProvider::withLocationIfReference(DataLocation::Storage, &_type);
 	set<Declaration const*> seenFunctions;
 	MemberList::MemberMap members;
-	for (ContractDefinition const* contract: _scope.annotation().linearizedBaseContracts)
-		for (UsingForDirective const* ufd: contract->usingForDirectives())
-		{
-			if (ufd->typeName() && *type != *TypeProvider::withLocationIfReference(
-				DataLocation::Storage,
-				ufd->typeName()->annotation().type
-			))
-				continue;
-			auto const& library = dynamic_cast<ContractDefinition const&>(
-				*ufd->libraryName().annotation().referencedDeclaration
-			);
-			for (FunctionDefinition const* function: library.definedFunctions())
-			{
-				if (!function->isVisibleAsLibraryMember() || seenFunctions.count(function))
-					continue;
-				seenFunctions.insert(function);
-				if (function->parameters().empty())
-					continue;
-				FunctionTypePointer fun = FunctionType(*function, false).asCallableFunction(true, true);
-				if (_type.isImplicitlyConvertibleTo(*fun->selfType()))
-					members.emplace_back(function->name(), fun, function);
-			}
-		}
+	for (auto const& usingFor: _scope.usingForFunctions())
+	{
+		if (usingFor.boundType && *type != *usingFor.boundType)
+			continue;
+		if (!seenFunctions.insert(usingFor.function).second)
+			continue;
+		if (_type.isImplicitlyConvertibleTo(*usingFor.functionType->selfType()))
+			members.emplace_back(usingFor.function->name(), usingFor.functionType, usingFor.function);
+	}
 	return members;
 }
 
@@ -1627,6 +1627,8 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -2349,6 +2351,8 @@ string TupleType::richIdentifier() const
 
 bool TupleType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (auto tupleType = dynamic_cast<TupleType const*>(&_other))
 		return components() == tupleType->components();
 	else
@@ -2692,6 +2696,8 @@ string FunctionType::richIdentifier() const
 
 bool FunctionType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FunctionType const& other = dynamic_cast<FunctionType const&>(_other);
@@ -3240,6 +3246,8 @@ string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
@@ -3368,6 +3376,8 @@ string ModifierType::richIdentifier() const
 
 bool ModifierType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ModifierType const& other = dynamic_cast<ModifierType const&>(_other);
@@ -38,6 +38,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 namespace dev
 {
@@ -114,20 +115,18 @@ public:
 	TypePointer memberType(std::string const& _name) const
 	{
 		TypePointer type = nullptr;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
+		for (size_t index: memberIndices(_name))
+		{
+			solAssert(!type, "Requested member type by non-unique name.");
+			type = m_memberTypes[index].type;
+		}
 		return type;
 	}
 	MemberMap membersByName(std::string const& _name) const
 	{
 		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
+		for (size_t index: memberIndices(_name))
+			members.push_back(m_memberTypes[index]);
 		return members;
 	}
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
@@ -140,7 +139,12 @@ public:
 	MemberMap::const_iterator end() const { return m_memberTypes.end(); }
 
 private:
+	/// @returns the indices of the members called @a _name in ascending order.
+	std::vector<size_t> const& memberIndices(std::string const& _name) const;
+
 	MemberMap m_memberTypes;
+	/// Indices of the members by name, will be lazy-initialized.
+	mutable std::unique_ptr<std::unordered_map<std::string, std::vector<size_t>>> m_memberIndex;
 	mutable std::unique_ptr<StorageOffsets> m_storageOffsets;
 };
 
@@ -324,7 +328,7 @@ protected:
 	}
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
-	mutable std::map<ContractDefinition const*, std::unique_ptr<MemberList>> m_members;
+	mutable std::unordered_map<ContractDefinition const*, std::unique_ptr<MemberList>> m_members;
 };
 
 /**
@@ -49,13 +49,27 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 	TypePointer targetBaseType = _targetType.isByteArray() ? uint256 : _targetType.baseType();
 	TypePointer sourceBaseType = _sourceType.isByteArray() ? uint256 : _sourceType.baseType();
 
-	// TODO unroll loop for small sizes
-
 	bool sourceIsStorage = _sourceType.location() == DataLocation::Storage;
 	bool fromCalldata = _sourceType.location() == DataLocation::CallData;
 	bool directCopy = sourceIsStorage && sourceBaseType->isValueType() && *sourceBaseType == *targetBaseType;
+	// Copies between static arrays that only touch a few slots are unrolled.
+	bool unrolledCopy =
+		directCopy &&
+		!_sourceType.isDynamicallySized() &&
+		!_targetType.isDynamicallySized() &&
+		_targetType.storageSize() <= 8;
+	// Value types from memory or calldata are combined into complete slots of the target
+	// instead of updating the slot for every element.
+	bool packedCopy =
+		!sourceIsStorage &&
+		sourceBaseType->isValueType() &&
+		targetBaseType->isValueType() &&
+		targetBaseType->storageBytes() <= 16 &&
+		targetBaseType->category() != Type::Category::Function;
 	bool haveByteOffsetSource = !directCopy && sourceIsStorage && sourceBaseType->storageBytes() <= 16;
-	bool haveByteOffsetTarget = !directCopy && targetBaseType->storageBytes() <= 16;
+	bool haveByteOffsetTarget = !directCopy && !packedCopy && targetBaseType->storageBytes() <= 16;
+	// Slots of packed arrays are always cleared as a whole.
+	TypePointer clearedType = targetBaseType->storageBytes() < 32 ? uint256 : targetBaseType;
 	unsigned byteOffsetSize = (haveByteOffsetSource ? 1 : 0) + (haveByteOffsetTarget ? 1 : 0);
 
 	// stack: source_ref [source_length] target_ref
@@ -156,6 +170,34 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 				_context << Instruction::DUP6 << Instruction::SSTORE;
 			}
 
+			if (unrolledCopy)
+			{
+				// stack: target_ref target_data_end source_length target_data_pos source_data_pos
+				unsigned sourceSlots = unsigned(_sourceType.storageSize());
+				unsigned targetSlots = unsigned(_targetType.storageSize());
+				solAssert(sourceSlots <= targetSlots, "");
+				for (unsigned slot = 0; slot < targetSlots; ++slot)
+				{
+					if (slot < sourceSlots)
+					{
+						_context << Instruction::DUP1;
+						if (slot > 0)
+							_context << u256(slot) << Instruction::ADD;
+						_context << Instruction::SLOAD;
+					}
+					else
+						_context << u256(0);
+					_context << Instruction::DUP3;
+					if (slot > 0)
+						_context << u256(slot) << Instruction::ADD;
+					_context << Instruction::SSTORE;
+				}
+				_context
+					<< Instruction::POP << Instruction::POP
+					<< Instruction::POP << Instruction::POP;
+				return;
+			}
+
 			// skip copying if source length is zero
 			_context << Instruction::DUP3 << Instruction::ISZERO;
 			_context.appendConditionalJumpTo(copyLoopEndWithoutByteOffset);
@@ -167,6 +209,16 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 			utils.convertLengthToSize(_sourceType);
 			_context << Instruction::DUP3 << Instruction::ADD;
 			// stack: target_ref target_data_end source_data_pos target_data_pos source_data_end
+			if (packedCopy)
+			{
+				utils.copyToPackedStorage(*sourceBaseType, *targetBaseType, fromCalldata);
+				// zero-out leftovers in target
+				_context << copyLoopEndWithoutByteOffset;
+				_context << Instruction::POP << Instruction::SWAP1 << Instruction::POP;
+				utils.clearStorageLoop(clearedType);
+				_context << Instruction::POP;
+				return;
+			}
 			if (haveByteOffsetTarget)
 				_context << u256(0);
 			if (haveByteOffsetSource)
@@ -281,7 +333,7 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 			// stack: target_ref target_data_end source_data_pos target_data_pos_updated source_data_end
 			_context << Instruction::POP << Instruction::SWAP1 << Instruction::POP;
 			// stack: target_ref target_data_end target_data_pos_updated
-			utils.clearStorageLoop(targetBaseType);
+			utils.clearStorageLoop(clearedType);
 			_context << Instruction::POP;
 		}
 	);
@@ -1132,6 +1184,64 @@ void ArrayUtils::accessIndex(ArrayType const& _arrayType, bool _doBoundsCheck, b
 	}
 }
 
+void ArrayUtils::copyToPackedStorage(Type const& _sourceBaseType, Type const& _targetBaseType, bool _fromCalldata) const
+{
+	solAssert(_sourceBaseType.isValueType() && _targetBaseType.isValueType(), "");
+	unsigned byteSize = _targetBaseType.storageBytes();
+	solAssert(0 < byteSize && byteSize <= 16, "");
+	unsigned itemsPerSlot = 32 / byteSize;
+	u256 sourceStride = _fromCalldata ? _sourceBaseType.calldataEncodedSize(true) : _sourceBaseType.memoryHeadSize();
+	// The multiplier reaches this value (modulo 2**256) after a slot has been filled.
+	u256 slotEndMultiplier = byteSize * itemsPerSlot == 32 ? u256(0) : u256(1) << (8 * byteSize * itemsPerSlot);
+
+	// stack: source_data_pos target_data_pos source_data_end
+	eth::AssemblyItem slotLoopStart = m_context.newTag();
+	eth::AssemblyItem loopEnd = m_context.newTag();
+	m_context << slotLoopStart;
+	m_context
+		<< Instruction::DUP3 << Instruction::DUP2
+		<< Instruction::GT << Instruction::ISZERO;
+	m_context.appendConditionalJumpTo(loopEnd);
+	m_context << u256(0) << u256(1);
+	// stack: source_data_pos target_data_pos source_data_end slot_value multiplier
+	eth::AssemblyItem itemLoopStart = m_context.newTag();
+	eth::AssemblyItem slotEnd = m_context.newTag();
+	m_context << itemLoopStart;
+	m_context << Instruction::DUP5;
+	CompilerUtils(m_context).loadFromMemoryDynamic(_sourceBaseType, _fromCalldata, true, false);
+	// convert to the storage representation, see StorageItem::storeValue
+	if (_targetBaseType.category() == Type::Category::FixedBytes)
+	{
+		solAssert(_sourceBaseType.category() == Type::Category::FixedBytes, "source not fixed bytes");
+		CompilerUtils(m_context).rightShiftNumberOnStack(256 - 8 * byteSize);
+	}
+	else
+		CompilerUtils(m_context).convertType(_sourceBaseType, _targetBaseType, true, true);
+	// stack: source_data_pos target_data_pos source_data_end slot_value multiplier value
+	m_context
+		<< Instruction::DUP2 << Instruction::MUL
+		<< Instruction::DUP3 << Instruction::OR
+		<< Instruction::SWAP2 << Instruction::POP;
+	// increment source
+	m_context << Instruction::SWAP4 << sourceStride << Instruction::ADD << Instruction::SWAP4;
+	// move on to the next item in the slot
+	m_context << (u256(1) << (8 * byteSize)) << Instruction::MUL;
+	m_context << Instruction::DUP1;
+	if (slotEndMultiplier == 0)
+		m_context << Instruction::ISZERO;
+	else
+		m_context << slotEndMultiplier << Instruction::EQ;
+	m_context.appendConditionalJumpTo(slotEnd);
+	m_context << Instruction::DUP5 << Instruction::DUP4 << Instruction::GT;
+	m_context.appendConditionalJumpTo(itemLoopStart);
+	m_context << slotEnd;
+	// store the slot and increment target
+	m_context << Instruction::POP << Instruction::DUP3 << Instruction::SSTORE;
+	m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD << Instruction::SWAP1;
+	m_context.appendJumpTo(slotLoopStart);
+	m_context << loopEnd;
+}
+
 void ArrayUtils::incrementByteOffset(unsigned _byteSize, unsigned _byteOffsetPosition, unsigned _storageOffsetPosition) const
 {
 	solAssert(_byteSize < 32, "");
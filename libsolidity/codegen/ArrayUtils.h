@@ -106,6 +106,12 @@ public:
 	void accessIndex(ArrayType const& _arrayType, bool _doBoundsCheck = true, bool _keepReference = false) const;
 
 private:
+	/// Appends a loop that copies value types from memory or calldata into a packed storage array.
+	/// Each slot is assembled on the stack and stored once, including zeros after the last item.
+	/// Stack pre: source_data_pos target_data_pos source_data_end
+	/// Stack post: source_data_pos target_data_pos source_data_end
+	/// where the positions have been moved past the copied data.
+	void copyToPackedStorage(Type const& _sourceBaseType, Type const& _targetBaseType, bool _fromCalldata) const;
 	/// Adds the given number of bytes to a storage byte offset counter and also increments
 	/// the storage offset if adding this number again would increase the counter over 32.
 	/// @param byteOffsetPosition the stack offset of the storage byte offset
@@ -32,6 +32,7 @@
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/backends/evm/AsmCodeGen.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/YulString.h>
 
@@ -419,8 +420,16 @@ void CompilerContext::appendInlineAssembly(
 	// so we essentially only optimize the ABI functions.
 	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
 	{
+		shared_ptr<yul::EVMDialect> dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
+		size_t runs = _optimiserSettings.expectedExecutionsPerDeployment;
+		if (_optimiserSettings.executionProfile && !m_visitedNodes.empty())
+			if (auto count = _optimiserSettings.executionProfile->locationCount(m_visitedNodes.top()->location()))
+				runs = *count;
+		// Only the creation context has a runtime context.
+		yul::GasMeter meter(*dialect, m_runtimeContext != nullptr, runs);
 		yul::OptimiserSuite::run(
-			yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+			dialect,
+			&meter,
 			*parserResult,
 			analysisInfo,
 			_optimiserSettings.optimizeStackAllocation,
@@ -495,8 +504,9 @@ void CompilerContext::updateSourceLocation()
 eth::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, false, m_evmVersion, 0, nullptr};
 	asmSettings.isCreation = true;
+	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
@@ -504,6 +514,7 @@ eth::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(Opt
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
+	asmSettings.executionProfile = _settings.executionProfile;
 	return asmSettings;
 }
 
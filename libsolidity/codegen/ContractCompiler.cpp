@@ -36,6 +36,10 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <set>
 
 using namespace std;
 using namespace dev;
@@ -338,6 +342,196 @@ void ContractCompiler::appendInternalSelector(
 namespace
 {
 
+/**
+ * Plans a function selector for functions with known call counts that minimises the gas
+ * for all calls plus the gas for deploying the code, using the cost model of
+ * ContractCompiler::appendInternalSelector.
+ *
+ * Like the uniform selector, it splits the sorted selectors into ranges, but the pivots are
+ * chosen by dynamic programming over all ranges and the selectors in the leaves are compared
+ * in decreasing order of their call counts. Before the search starts, the most frequently
+ * called functions can be compared against directly, which pays off if a few functions
+ * receive most of the calls.
+ */
+class WeightedSelectorPlanner
+{
+public:
+	/// Compares against the selectors in @a checks one after the other and then either
+	/// continues at @a larger or @a smaller depending on whether the selector is less than
+	/// @a pivot or jumps to the "not found" tag if there are no children.
+	struct Node
+	{
+		vector<FixedHash<4>> checks;
+		FixedHash<4> pivot;
+		unique_ptr<Node> larger;
+		unique_ptr<Node> smaller;
+	};
+
+	WeightedSelectorPlanner(vector<FixedHash<4>> const& _sortedIDs, map<FixedHash<4>, size_t> const& _callCounts):
+		m_sortedIDs(_sortedIDs), m_callCounts(_callCounts)
+	{}
+
+	unique_ptr<Node> plan() const
+	{
+		solAssert(!m_sortedIDs.empty(), "");
+		vector<FixedHash<4>> byCount = m_sortedIDs;
+		stable_sort(byCount.begin(), byCount.end(), [&](FixedHash<4> const& _a, FixedHash<4> const& _b) {
+			return count(_a) > count(_b);
+		});
+
+		// Try to compare against the first few functions by call count directly.
+		unique_ptr<Node> best;
+		double bestCost = numeric_limits<double>::infinity();
+		for (size_t peeled = 0; peeled <= maxPeeled && peeled < m_sortedIDs.size(); ++peeled)
+		{
+			// Comparing against functions that are never called first does not pay off.
+			if (peeled > 0 && count(byCount[peeled - 1]) == 0)
+				break;
+			set<FixedHash<4>> peeledIDs(byCount.begin(), byCount.begin() + peeled);
+			vector<FixedHash<4>> remaining;
+			for (auto const& id: m_sortedIDs)
+				if (!peeledIDs.count(id))
+					remaining.push_back(id);
+
+			double cost = 0;
+			for (size_t i = 0; i < peeled; ++i)
+				cost += (i + 1) * comparisonGas * count(byCount[i]) + comparisonBytes * createDataGas;
+			cost += peeled * comparisonGas * totalCount(remaining, 0, remaining.size());
+
+			Table table = solve(remaining);
+			cost += table.costs[0][remaining.size()];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				best = build(remaining, table, 0, remaining.size());
+				best->checks.insert(best->checks.begin(), byCount.begin(), byCount.begin() + peeled);
+			}
+		}
+		return best;
+	}
+
+private:
+	/// Gas costs and size of "dup1 push4 <id> eq/gt push <tag> jumpi".
+	static double constexpr comparisonGas = 22;
+	static double constexpr comparisonBytes = 11;
+	/// Size of the jump to the "not found" tag at the end of a leaf.
+	static double constexpr leafExitBytes = 4;
+	static double constexpr createDataGas = eth::GasCosts::createDataGas;
+	/// Maximum number of functions compared against before the search.
+	static size_t constexpr maxPeeled = 4;
+
+	/// Optimal costs and split points of all ranges [l, r) of selectors, indexed by l and r.
+	/// A split point of zero denotes a leaf.
+	struct Table
+	{
+		vector<vector<double>> costs;
+		vector<vector<size_t>> splits;
+	};
+
+	double count(FixedHash<4> const& _id) const
+	{
+		auto it = m_callCounts.find(_id);
+		return it == m_callCounts.end() ? 0 : double(it->second);
+	}
+
+	double totalCount(vector<FixedHash<4>> const& _ids, size_t _begin, size_t _end) const
+	{
+		double sum = 0;
+		for (size_t i = _begin; i < _end; ++i)
+			sum += count(_ids[i]);
+		return sum;
+	}
+
+	vector<FixedHash<4>> leafOrder(vector<FixedHash<4>> const& _ids, size_t _begin, size_t _end) const
+	{
+		vector<FixedHash<4>> order(_ids.begin() + _begin, _ids.begin() + _end);
+		stable_sort(order.begin(), order.end(), [&](FixedHash<4> const& _a, FixedHash<4> const& _b) {
+			return count(_a) > count(_b);
+		});
+		return order;
+	}
+
+	Table solve(vector<FixedHash<4>> const& _ids) const
+	{
+		size_t const n = _ids.size();
+		vector<double> counts;
+		for (auto const& id: _ids)
+			counts.push_back(count(id));
+		Table table{
+			vector<vector<double>>(n + 1, vector<double>(n + 1, 0)),
+			vector<vector<size_t>>(n + 1, vector<size_t>(n + 1, 0))
+		};
+		// Costs of the comparisons in the leaves for all ranges, computed by inserting one
+		// count after the other into the descending order of the counts of the range.
+		vector<vector<double>> leafGas(n + 1, vector<double>(n + 1, 0));
+		for (size_t l = 0; l < n; ++l)
+		{
+			vector<double> order;
+			double gas = 0;
+			for (size_t r = l + 1; r <= n; ++r)
+			{
+				double c = counts[r - 1];
+				auto position = upper_bound(order.begin(), order.end(), c, greater<double>());
+				// All lighter functions need one more comparison.
+				gas += comparisonGas * (size_t(position - order.begin()) + 1) * c;
+				for (auto it = position; it != order.end(); ++it)
+					gas += comparisonGas * *it;
+				order.insert(position, c);
+				leafGas[l][r] = gas;
+			}
+		}
+
+		for (size_t length = 1; length <= n; ++length)
+			for (size_t l = 0; l + length <= n; ++l)
+			{
+				size_t r = l + length;
+				double cost = leafGas[l][r] + (comparisonBytes * length + leafExitBytes) * createDataGas;
+				size_t split = 0;
+				if (length > 1)
+				{
+					// The split adds a comparison for all calls and its tag to the code.
+					double total = 0;
+					for (size_t i = l; i < r; ++i)
+						total += counts[i];
+					double splitCost = comparisonGas * total + (comparisonBytes + 1) * createDataGas;
+					for (size_t pivot = l + 1; pivot < r; ++pivot)
+						if (splitCost + table.costs[l][pivot] + table.costs[pivot][r] < cost)
+						{
+							cost = splitCost + table.costs[l][pivot] + table.costs[pivot][r];
+							split = pivot;
+						}
+				}
+				table.costs[l][r] = cost;
+				table.splits[l][r] = split;
+			}
+		return table;
+	}
+
+	unique_ptr<Node> build(vector<FixedHash<4>> const& _ids, Table const& _table, size_t _begin, size_t _end) const
+	{
+		auto node = make_unique<Node>();
+		size_t split = _begin < _end ? _table.splits[_begin][_end] : 0;
+		if (split == 0)
+			node->checks = leafOrder(_ids, _begin, _end);
+		else
+		{
+			node->pivot = _ids[split];
+			node->larger = build(_ids, _table, split, _end);
+			node->smaller = build(_ids, _table, _begin, split);
+		}
+		return node;
+	}
+
+	vector<FixedHash<4>> const& m_sortedIDs;
+	map<FixedHash<4>, size_t> const& m_callCounts;
+};
+
+double constexpr WeightedSelectorPlanner::comparisonGas;
+double constexpr WeightedSelectorPlanner::comparisonBytes;
+double constexpr WeightedSelectorPlanner::leafExitBytes;
+double constexpr WeightedSelectorPlanner::createDataGas;
+size_t constexpr WeightedSelectorPlanner::maxPeeled;
+
 // Helper function to check if any function is payable
 bool hasPayableFunctions(ContractDefinition const& _contract)
 {
@@ -354,6 +548,35 @@ bool hasPayableFunctions(ContractDefinition const& _contract)
 
 }
 
+void ContractCompiler::appendWeightedSelector(
+	map<FixedHash<4>, eth::AssemblyItem const> const& _entryPoints,
+	vector<FixedHash<4>> const& _ids,
+	map<FixedHash<4>, size_t> const& _callCounts,
+	eth::AssemblyItem const& _notFoundTag
+)
+{
+	using Node = WeightedSelectorPlanner::Node;
+	function<void(Node const&)> appendNode = [&](Node const& _node)
+	{
+		for (auto const& id: _node.checks)
+		{
+			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
+			m_context.appendConditionalJumpTo(_entryPoints.at(id));
+		}
+		if (_node.larger)
+		{
+			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(_node.pivot)) << Instruction::GT;
+			eth::AssemblyItem lessTag{m_context.appendConditionalJump()};
+			appendNode(*_node.larger);
+			m_context << lessTag;
+			appendNode(*_node.smaller);
+		}
+		else
+			m_context.appendJumpTo(_notFoundTag);
+	};
+	appendNode(*WeightedSelectorPlanner(_ids, _callCounts).plan());
+}
+
 void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contract)
 {
 	map<FixedHash<4>, FunctionTypePointer> interfaceFunctions = _contract.interfaceFunctions();
@@ -387,13 +610,20 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 
 		// stack now is: <can-call-non-view-functions>? <funhash>
 		vector<FixedHash<4>> sortedIDs;
+		map<FixedHash<4>, size_t> callCounts;
 		for (auto const& it: interfaceFunctions)
 		{
 			callDataUnpackerEntryPoints.emplace(it.first, m_context.newTag());
 			sortedIDs.emplace_back(it.first);
+			if (m_optimiserSettings.executionProfile)
+				if (auto count = m_optimiserSettings.executionProfile->functionCount(it.second->externalSignature()))
+					callCounts[it.first] = *count;
 		}
 		std::sort(sortedIDs.begin(), sortedIDs.end());
-		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		if (callCounts.empty())
+			appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		else
+			appendWeightedSelector(callDataUnpackerEntryPoints, sortedIDs, callCounts, notFound);
 	}
 
 	m_context << notFound;
@@ -94,6 +94,15 @@ private:
 		eth::AssemblyItem const& _notFoundTag,
 		size_t _runs
 	);
+	/// Appends a function selector whose shape minimises the costs for the given number of
+	/// calls of each function, i.e. frequently called functions need fewer comparisons.
+	/// @a _ids have to be sorted.
+	void appendWeightedSelector(
+		std::map<FixedHash<4>, eth::AssemblyItem const> const& _entryPoints,
+		std::vector<FixedHash<4>> const& _ids,
+		std::map<FixedHash<4>, size_t> const& _callCounts,
+		eth::AssemblyItem const& _notFoundTag
+	);
 	void appendFunctionSelector(ContractDefinition const& _contract);
 	void appendCallValueCheck();
 	void appendReturnValuePacker(TypePointers const& _typeParameters, bool _isLibrary);
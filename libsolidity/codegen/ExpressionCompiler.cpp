@@ -44,6 +44,32 @@ using namespace dev;
 using namespace dev::eth;
 using namespace dev::solidity;
 
+namespace
+{
+
+/// @returns true if @a _expression is a call to one of the ``abi.encode`` functions.
+/// Their result is a newly allocated byte array that nothing else refers to yet.
+bool isABIEncodeCall(Expression const& _expression)
+{
+	auto const* call = dynamic_cast<FunctionCall const*>(&_expression);
+	if (!call || call->annotation().kind != FunctionCallKind::FunctionCall)
+		return false;
+	auto const* function = dynamic_cast<FunctionType const*>(call->expression().annotation().type);
+	if (!function)
+		return false;
+	switch (function->kind())
+	{
+	case FunctionType::Kind::ABIEncode:
+	case FunctionType::Kind::ABIEncodePacked:
+	case FunctionType::Kind::ABIEncodeWithSelector:
+	case FunctionType::Kind::ABIEncodeWithSignature:
+		return true;
+	default:
+		return false;
+	}
+}
+
+}
 
 void ExpressionCompiler::compile(Expression const& _expression)
 {
@@ -729,21 +755,38 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 			solAssert(!function.padArguments(), "");
 			TypePointer const& argType = arguments.front()->annotation().type;
 			solAssert(argType, "");
+			// Optimization: The hash of a literal string is computed at compile time.
+			if (auto literalType = dynamic_cast<StringLiteralType const*>(argType))
+			{
+				m_context << u256(h256::Arith(dev::keccak256(literalType->value())));
+				break;
+			}
 			arguments.front()->accept(*this);
 			// Optimization: If type is bytes or string, then do not encode,
 			// but directly compute keccak256 on memory.
 			if (*argType == *TypeProvider::bytesMemory() || *argType == *TypeProvider::stringMemory())
 			{
+				// The array returned by abi.encode... was allocated last and is not
+				// used after hashing, so its memory is released again.
+				bool temporary = isABIEncodeCall(*arguments.front());
+				if (temporary)
+					m_context << Instruction::DUP1;
 				ArrayUtils(m_context).retrieveLength(*TypeProvider::bytesMemory());
 				m_context << Instruction::SWAP1 << u256(0x20) << Instruction::ADD;
+				m_context << Instruction::KECCAK256;
+				if (temporary)
+				{
+					m_context << Instruction::SWAP1;
+					utils().storeFreeMemoryPointer();
+				}
 			}
 			else
 			{
 				utils().fetchFreeMemoryPointer();
 				utils().packedEncode({argType}, TypePointers());
 				utils().toSizeAfterFreeMemoryPointer();
+				m_context << Instruction::KECCAK256;
 			}
-			m_context << Instruction::KECCAK256;
 			break;
 		}
 		case FunctionType::Kind::Log0:
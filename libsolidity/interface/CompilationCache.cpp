@@ -0,0 +1,159 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Content-addressed on-disk cache for standard JSON compilation results.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+string const c_entryExtension = ".json";
+}
+
+CompilationCache::CompilationCache(fs::path _directory, uint64_t _maxSize):
+	m_directory(std::move(_directory)),
+	m_maxSize(_maxSize)
+{
+}
+
+h256 CompilationCache::key(string const& _canonicalInput)
+{
+	return keccak256(VersionString + '\0' + _canonicalInput);
+}
+
+boost::optional<Json::Value> CompilationCache::lookup(h256 const& _key, ReadCallback::Callback const& _readFile)
+{
+	try
+	{
+		fs::path path = entryPath(_key);
+		if (!fs::is_regular_file(path))
+			return boost::none;
+
+		Json::Value entry;
+		if (!jsonParseStrict(readFileAsString(path.string()), entry) || !entry["output"].isObject())
+			return boost::none;
+
+		for (auto const& import: entry["imports"].getMemberNames())
+		{
+			if (!_readFile)
+				return boost::none;
+			ReadCallback::Result result = _readFile(import);
+			if (!result.success || "0x" + keccak256(result.responseOrErrorMessage).hex() != entry["imports"][import].asString())
+				return boost::none;
+		}
+
+		// Mark the entry as recently used for eviction.
+		fs::last_write_time(path, time(nullptr));
+		return entry["output"];
+	}
+	catch (...)
+	{
+		return boost::none;
+	}
+}
+
+void CompilationCache::store(h256 const& _key, Json::Value const& _output, map<string, h256> const& _imports)
+{
+	try
+	{
+		Json::Value entry(Json::objectValue);
+		entry["imports"] = Json::objectValue;
+		for (auto const& import: _imports)
+			entry["imports"][import.first] = "0x" + import.second.hex();
+		entry["output"] = _output;
+
+		fs::create_directories(m_directory);
+		// Write to a temporary file first so that concurrent compiler runs never see partial entries.
+		fs::path temporary = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+		{
+			ofstream file(temporary.string(), ios::binary);
+			file << jsonCompactPrint(entry);
+			if (!file)
+			{
+				file.close();
+				fs::remove(temporary);
+				return;
+			}
+		}
+		fs::rename(temporary, entryPath(_key));
+		evict();
+	}
+	catch (...)
+	{
+	}
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + c_entryExtension);
+}
+
+void CompilationCache::evict()
+{
+	if (m_maxSize == 0)
+		return;
+
+	struct Entry
+	{
+		fs::path path;
+		uint64_t size;
+		time_t lastUse;
+	};
+	vector<Entry> entries;
+	uint64_t totalSize = 0;
+	for (fs::directory_iterator it(m_directory); it != fs::directory_iterator(); ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == c_entryExtension)
+		{
+			uint64_t size = fs::file_size(it->path());
+			entries.push_back({it->path(), size, fs::last_write_time(it->path())});
+			totalSize += size;
+		}
+
+	if (totalSize <= m_maxSize)
+		return;
+
+	sort(entries.begin(), entries.end(), [](Entry const& _a, Entry const& _b) { return _a.lastUse < _b.lastUse; });
+	for (Entry const& entry: entries)
+	{
+		if (totalSize <= m_maxSize)
+			break;
+		boost::system::error_code error;
+		fs::remove(entry.path, error);
+		if (!error)
+			totalSize -= entry.size;
+	}
+}
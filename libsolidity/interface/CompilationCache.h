@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Content-addressed on-disk cache for standard JSON compilation results.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <json/json.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Stores standard JSON outputs in a directory, one file per entry, addressed by the
+ * Keccak256 hash of the compiler version and the canonical compilation input (source
+ * contents, settings and output selection).
+ *
+ * Files that were only loaded through import statements are not part of the key. Their
+ * hashes are recorded with the entry and re-checked through the read callback on lookup.
+ *
+ * All filesystem errors are swallowed: a broken cache results in a cache miss, never in a
+ * failed compilation.
+ */
+class CompilationCache: boost::noncopyable
+{
+public:
+	/// @param _directory directory holding the entries, created on first store.
+	/// @param _maxSize maximum total size of all entries in bytes. If exceeded after a store,
+	/// the least recently used entries are removed. Zero means unbounded.
+	CompilationCache(boost::filesystem::path _directory, uint64_t _maxSize = 0);
+
+	/// @returns the key for the given canonical input, which must fully determine the
+	/// compiler output apart from imported files.
+	static h256 key(std::string const& _canonicalInput);
+
+	/// @returns the output stored under @a _key if present and if every imported file
+	/// recorded with it still has the same content when read through @a _readFile.
+	boost::optional<Json::Value> lookup(h256 const& _key, ReadCallback::Callback const& _readFile);
+
+	/// Stores @a _output under @a _key, together with the hashes of @a _imports
+	/// (paths as passed to the read callback). Evicts old entries if the size limit is exceeded.
+	void store(h256 const& _key, Json::Value const& _output, std::map<std::string, h256> const& _imports);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(h256 const& _key) const;
+	/// Removes least recently used entries until the total size is below the limit.
+	void evict();
+
+	boost::filesystem::path m_directory;
+	uint64_t m_maxSize = 0;
+};
+
+}
+}
@@ -57,6 +57,7 @@
 
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
 
 #include <json/json.h>
 
@@ -198,6 +199,7 @@ bool CompilerStack::parse()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
 	ASTNode::resetID();
+	ScopedTimer timer("parsing");
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
@@ -244,81 +246,98 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsingSuccessful || m_stackState >= AnalysisSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was successful."));
+	ScopedTimer timer("analysis");
 	resolveImports();
 
 	bool noErrors = true;
 
 	try {
-		SyntaxChecker syntaxChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			ScopedTimer passTimer("SyntaxChecker");
+			SyntaxChecker syntaxChecker(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+		{
+			ScopedTimer passTimer("DocStringAnalyser");
+			DocStringAnalyser docStringAnalyser(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!docStringAnalyser.analyseDocStrings(*source->ast))
+					noErrors = false;
+		}
 
-		m_globalContext = make_shared<GlobalContext>();
-		NameAndTypeResolver resolver(m_globalContext->declarations(), m_scopes, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.registerDeclarations(*source->ast))
-				return false;
-
-		map<string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
-
-		// This is the main name and type resolution loop. Needs to be run for every contract, because
-		// the special variables "this" and "super" must be set appropriately.
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-				{
-					m_globalContext->setCurrentContract(*contract);
-					if (!resolver.updateDeclaration(*m_globalContext->currentThis())) return false;
-					if (!resolver.updateDeclaration(*m_globalContext->currentSuper())) return false;
-					if (!resolver.resolveNamesAndTypes(*contract)) return false;
-
-					// Note that we now reference contracts by their fully qualified names, and
-					// thus contracts can only conflict if declared in the same source file.  This
-					// already causes a double-declaration error elsewhere, so we do not report
-					// an error here and instead silently drop any additional contracts we find.
-					if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-						m_contracts[contract->fullyQualifiedName()].contract = contract;
-				}
+		{
+			ScopedTimer passTimer("NameAndTypeResolver");
+			m_globalContext = make_shared<GlobalContext>();
+			NameAndTypeResolver resolver(m_globalContext->declarations(), m_scopes, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!resolver.registerDeclarations(*source->ast))
+					return false;
 
-		// Next, we check inheritance, overrides, function collisions and other things at
-		// contract or function level.
-		// This also calculates whether a contract is abstract, which is needed by the
-		// type checker.
-		ContractLevelChecker contractLevelChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!contractLevelChecker.check(*contract))
-						noErrors = false;
+			map<string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (!resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		// New we run full type checks that go down to the expression level. This
-		// cannot be done earlier, because we need cross-contract types and information
-		// about whether a contract is abstract for the `new` expression.
-		// This populates the `type` annotation for all expressions.
-		//
-		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
-		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+			// This is the main name and type resolution loop. Needs to be run for every contract, because
+			// the special variables "this" and "super" must be set appropriately.
+			for (Source const* source: m_sourceOrder)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					{
+						m_globalContext->setCurrentContract(*contract);
+						if (!resolver.updateDeclaration(*m_globalContext->currentThis())) return false;
+						if (!resolver.updateDeclaration(*m_globalContext->currentSuper())) return false;
+						if (!resolver.resolveNamesAndTypes(*contract)) return false;
+
+						// Note that we now reference contracts by their fully qualified names, and
+						// thus contracts can only conflict if declared in the same source file.  This
+						// already causes a double-declaration error elsewhere, so we do not report
+						// an error here and instead silently drop any additional contracts we find.
+						if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
+							m_contracts[contract->fullyQualifiedName()].contract = contract;
+					}
+		}
+
+		{
+			// Next, we check inheritance, overrides, function collisions and other things at
+			// contract or function level.
+			// This also calculates whether a contract is abstract, which is needed by the
+			// type checker.
+			ScopedTimer passTimer("ContractLevelChecker");
+			ContractLevelChecker contractLevelChecker(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						if (!contractLevelChecker.check(*contract))
+							noErrors = false;
+		}
+
+		{
+			// New we run full type checks that go down to the expression level. This
+			// cannot be done earlier, because we need cross-contract types and information
+			// about whether a contract is abstract for the `new` expression.
+			// This populates the `type` annotation for all expressions.
+			//
+			// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
+			// which is only done one step later.
+			ScopedTimer passTimer("TypeChecker");
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						if (!typeChecker.checkTypeRequirements(*contract))
+							noErrors = false;
+		}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			ScopedTimer passTimer("PostTypeChecker");
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (!postTypeChecker.check(*source->ast))
@@ -329,6 +348,7 @@ bool CompilerStack::analyze()
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			ScopedTimer passTimer("ControlFlowAnalyzer");
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (!cfg.constructFlow(*source->ast))
@@ -346,6 +366,7 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
+			ScopedTimer passTimer("StaticAnalyzer");
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (!staticAnalyzer.analyze(*source->ast))
@@ -355,6 +376,7 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			ScopedTimer passTimer("ViewPureChecker");
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
 				ast.push_back(source->ast);
@@ -365,6 +387,7 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
+			ScopedTimer passTimer("SMTChecker");
 			SMTChecker smtChecker(m_errorReporter, m_smtlib2Responses);
 			for (Source const* source: m_sourceOrder)
 				smtChecker.analyze(*source->ast, source->scanner);
@@ -406,6 +429,7 @@ bool CompilerStack::compile()
 		if (!parseAndAnalyze())
 			return false;
 
+	ScopedTimer timer("code generation");
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 	for (Source const* source: m_sourceOrder)
@@ -890,6 +914,25 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 			return false;
 	return true;
 }
+
+/// @returns a copy of @a _profile where the call counts of the external functions of
+/// @a _contract also apply to their source ranges, unless these are profiled explicitly.
+shared_ptr<eth::ExecutionProfile const> contractExecutionProfile(
+	eth::ExecutionProfile const& _profile,
+	ContractDefinition const& _contract
+)
+{
+	auto profile = make_shared<eth::ExecutionProfile>(_profile);
+	for (auto const& function: _contract.interfaceFunctions())
+	{
+		SourceLocation const& location = function.second->declaration().location();
+		if (!location.source || profile->hasLocation(location))
+			continue;
+		if (auto count = _profile.functionCount(function.second->externalSignature()))
+			profile->setLocationCount(location.source->name(), location.start, location.end - location.start, *count);
+	}
+	return profile;
+}
 }
 
 void CompilerStack::compileContract(
@@ -904,9 +947,13 @@ void CompilerStack::compileContract(
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		compileContract(*dependency, _otherCompilers);
 
+	ScopedTimer timer(_contract.fullyQualifiedName());
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
+	OptimiserSettings optimiserSettings = m_optimiserSettings;
+	if (optimiserSettings.executionProfile)
+		optimiserSettings.executionProfile = contractExecutionProfile(*optimiserSettings.executionProfile, _contract);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, optimiserSettings);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(
@@ -924,6 +971,7 @@ void CompilerStack::compileContract(
 		solAssert(false, "Optimizer exception during compilation");
 	}
 
+	ScopedTimer assemblyTimer("assembly");
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -961,6 +1009,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		generateIR(*dependency);
 
+	ScopedTimer timer("IR generation " + _contract.fullyQualifiedName());
 	IRGenerator generator(m_evmVersion, m_optimiserSettings);
 	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
 }
@@ -1043,6 +1092,7 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.executionProfile.reset();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1056,6 +1106,7 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["peephole"] = m_optimiserSettings.runPeephole;
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
+		details["inliner"] = m_optimiserSettings.runInliner;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
@@ -1066,6 +1117,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
 	}
+	if (m_optimiserSettings.executionProfile)
+		meta["settings"]["optimizer"]["executionProfile"] = m_optimiserSettings.executionProfile->toJson();
 
 	if (m_metadataLiteralSources)
 		meta["settings"]["metadata"]["useLiteralContent"] = true;
@@ -22,7 +22,10 @@
 
 #pragma once
 
+#include <libevmasm/ExecutionProfile.h>
+
 #include <cstddef>
+#include <memory>
 
 namespace dev
 {
@@ -49,6 +52,7 @@ struct OptimiserSettings
 	{
 		OptimiserSettings s;
 		s.runOrderLiterals = true;
+		s.runInliner = true;
 		s.runJumpdestRemover = true;
 		s.runPeephole = true;
 		s.runDeduplicate = true;
@@ -73,6 +77,7 @@ struct OptimiserSettings
 	{
 		return
 			runOrderLiterals == _other.runOrderLiterals &&
+			runInliner == _other.runInliner &&
 			runJumpdestRemover == _other.runJumpdestRemover &&
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
@@ -80,12 +85,17 @@ struct OptimiserSettings
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			(executionProfile == _other.executionProfile || (
+				executionProfile && _other.executionProfile && *executionProfile == *_other.executionProfile
+			));
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
 	/// This helps exploiting associativity.
 	bool runOrderLiterals = false;
+	/// Inliner of small internal functions based on assembly items.
+	bool runInliner = false;
 	/// Non-referenced jump destination remover.
 	bool runJumpdestRemover = false;
 	/// Peephole optimizer
@@ -104,6 +114,10 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Execution counts collected from traces. The code covered by the profile is optimised
+	/// for the profiled number of executions instead of @a expectedExecutionsPerDeployment
+	/// and the function dispatcher checks frequently called functions first.
+	std::shared_ptr<eth::ExecutionProfile const> executionProfile;
 };
 
 }
@@ -25,9 +25,11 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <libevmasm/ExecutionProfile.h>
 #include <libevmasm/Instruction.h>
 #include <libdevcore/JSON.h>
 #include <libdevcore/Keccak256.h>
+#include <libdevcore/Profiler.h>
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string.hpp>
@@ -100,22 +102,6 @@ Json::Value formatErrorWithException(
 	return formatError(_warning, _type, _component, message, formattedMessage, sourceLocation);
 }
 
-set<string> requestedContractNames(Json::Value const& _outputSelection)
-{
-	set<string> names;
-	for (auto const& sourceName: _outputSelection.getMemberNames())
-	{
-		for (auto const& contractName: _outputSelection[sourceName].getMemberNames())
-		{
-			/// Consider the "all sources" shortcuts as requesting everything.
-			if (contractName == "*" || contractName == "")
-				return set<string>();
-			names.insert((sourceName == "*" ? "" : sourceName) + ":" + contractName);
-		}
-	}
-	return names;
-}
-
 /// Returns true iff @a _hash (hex with 0x prefix) is the Keccak256 hash of the binary data in @a _content.
 bool hashMatchesContent(string const& _hash, string const& _content)
 {
@@ -190,12 +176,10 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _fil
 	return false;
 }
 
-/// @returns true if any binary was requested, i.e. we actually have to perform compilation.
-bool isBinaryRequested(Json::Value const& _outputSelection)
+/// @returns true if any of the artifacts in @a _requests (the artifacts requested for a single
+/// contract) can only be produced by generating code.
+bool requiresBinaries(Json::Value const& _requests)
 {
-	if (!_outputSelection.isObject())
-		return false;
-
 	// This does not inculde "evm.methodIdentifiers" on purpose!
 	static vector<string> const outputsThatRequireBinaries{
 		"*",
@@ -207,14 +191,50 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
 	};
 
-	for (auto const& fileRequests: _outputSelection)
-		for (auto const& requests: fileRequests)
-			for (auto const& output: outputsThatRequireBinaries)
-				if (isArtifactRequested(requests, output, false))
+	for (auto const& output: outputsThatRequireBinaries)
+		if (isArtifactRequested(_requests, output, false))
+			return true;
+	return false;
+}
+
+/// @returns true if any binary was requested, i.e. we actually have to perform compilation.
+bool isBinaryRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& sourceName: _outputSelection.getMemberNames())
+		if (_outputSelection[sourceName].isObject())
+			for (auto const& contractName: _outputSelection[sourceName].getMemberNames())
+				// Source unit level artifacts (the empty contract name) never require binaries.
+				if (!contractName.empty() && requiresBinaries(_outputSelection[sourceName][contractName]))
 					return true;
 	return false;
 }
 
+/// @returns the names of the contracts whose requested artifacts require binaries, either
+/// as "source:contract" or, if requested for all sources, as "contract".
+/// An empty set requests binaries for all contracts.
+set<string> requestedContractNames(Json::Value const& _outputSelection)
+{
+	set<string> names;
+	if (!_outputSelection.isObject())
+		return names;
+
+	for (auto const& sourceName: _outputSelection.getMemberNames())
+		if (_outputSelection[sourceName].isObject())
+			for (auto const& contractName: _outputSelection[sourceName].getMemberNames())
+			{
+				if (contractName.empty() || !requiresBinaries(_outputSelection[sourceName][contractName]))
+					continue;
+				/// Consider the "all contracts" shortcut as requesting everything.
+				if (contractName == "*")
+					return set<string>();
+				names.insert(sourceName == "*" ? contractName : sourceName + ":" + contractName);
+			}
+	return names;
+}
+
 /// @returns true if any Yul IR was requested. Note that as an exception, '*' does not
 /// yet match "ir" or "irOptimized"
 bool isIRRequested(Json::Value const& _outputSelection)
@@ -301,19 +321,25 @@ boost::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"debug", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
+boost::optional<Json::Value> checkDebugKeys(Json::Value const& _input)
+{
+	static set<string> keys{"profile"};
+	return checkKeys(_input, keys, "settings.debug");
+}
+
 boost::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "executionProfile", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
 boost::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "inliner", "constantOptimizer", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -404,6 +430,16 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("executionProfile"))
+	{
+		auto profile = eth::ExecutionProfile::fromJson(_jsonInput["executionProfile"]);
+		if (profile.type() == typeid(string))
+			return formatFatalError("JSONError", boost::get<string>(profile));
+		if (!_jsonInput["enabled"].asBool())
+			return formatFatalError("JSONError", "The \"executionProfile\" setting requires the optimizer to be enabled.");
+		settings.executionProfile = make_shared<eth::ExecutionProfile const>(boost::get<eth::ExecutionProfile>(std::move(profile)));
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -420,6 +456,8 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "cse", settings.runCSE))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "inliner", settings.runInliner))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
@@ -656,6 +694,18 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 
 	ret.metadataLiteralSources = metadataSettings.get("useLiteralContent", Json::Value(false)).asBool();
 
+	Json::Value debugSettings = settings.get("debug", Json::Value());
+
+	if (auto result = checkDebugKeys(debugSettings))
+		return *result;
+
+	if (debugSettings.isMember("profile"))
+	{
+		if (!debugSettings["profile"].isBool())
+			return formatFatalError("JSONError", "\"settings.debug.profile\" must be Boolean");
+		ret.profile = debugSettings["profile"].asBool();
+	}
+
 	Json::Value outputSelection = settings.get("outputSelection", Json::Value());
 
 	if (auto jsonError = checkOutputSelection(outputSelection))
@@ -782,6 +832,11 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	bool const analysisSuccess = compilerStack.state() >= CompilerStack::State::AnalysisSuccessful;
 	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
 
+	if (m_cache && analysisSuccess)
+		for (string const& sourceName: compilerStack.sourceNames())
+			if (!sourceList.count(sourceName))
+				m_importedSources[sourceName] = keccak256(compilerStack.scanner(sourceName).source());
+
 	/// Inconsistent state - stop here to receive error reports from users
 	if (((binariesRequested && !compilationSuccess) || !analysisSuccess) && errors.empty())
 		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
@@ -963,6 +1018,21 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 
+string StandardCompiler::canonicalCacheInput(Json::Value const& _input, InputsAndSettings const& _inputsAndSettings)
+{
+	// Sources are keyed by content because they might have been loaded through URLs.
+	// JSON objects are serialised with sorted keys, so the result does not depend
+	// on the order in the original input.
+	Json::Value canonical(Json::objectValue);
+	canonical["language"] = _inputsAndSettings.language;
+	canonical["sources"] = Json::objectValue;
+	for (auto const& source: _inputsAndSettings.sources)
+		canonical["sources"][source.first] = "0x" + keccak256(source.second).hex();
+	canonical["settings"] = _input.get("settings", Json::Value());
+	canonical["auxiliaryInput"] = _input.get("auxiliaryInput", Json::Value());
+	return jsonCompactPrint(canonical);
+}
+
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
 	try
@@ -971,12 +1041,50 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 		if (parsed.type() == typeid(Json::Value))
 			return boost::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
+
+		// Profiling results depend on the run, so they bypass the cache.
+		bool const profile = settings.profile;
+		bool const useCache = m_cache && !profile;
+		if (profile)
+		{
+			Profiler::instance().reset();
+			Profiler::instance().enable();
+		}
+		ScopeGuard disableProfiler([&]() {
+			if (profile)
+				Profiler::instance().enable(false);
+		});
+
+		h256 cacheKey;
+		if (useCache)
+		{
+			cacheKey = CompilationCache::key(canonicalCacheInput(_input, settings));
+			if (auto output = m_cache->lookup(cacheKey, m_readFile))
+				return *output;
+		}
+		m_importedSources.clear();
+
+		Json::Value output;
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			output = compileSolidity(std::move(settings));
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+			output = compileYul(std::move(settings));
 		else
 			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+
+		// Only successful results are cached. Requests for SMT queries are not final either.
+		if (useCache && !output.isMember("auxiliaryInputRequested"))
+		{
+			bool success = true;
+			for (auto const& error: output.get("errors", Json::arrayValue))
+				if (error["severity"] != "warning")
+					success = false;
+			if (success)
+				m_cache->store(cacheKey, output, m_importedSources);
+		}
+		if (profile)
+			output["profile"] = Profiler::instance().toJson();
+		return output;
 	}
 	catch (Json::LogicError const& _exception)
 	{
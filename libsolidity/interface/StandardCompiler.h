@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <boost/optional.hpp>
@@ -48,6 +49,10 @@ public:
 	{
 	}
 
+	/// Enables lookup and storage of compilation results in @a _cache.
+	/// Passing a null pointer disables caching.
+	void setCache(std::shared_ptr<CompilationCache> _cache) { m_cache = std::move(_cache); }
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json::Value compile(Json::Value const& _input) noexcept;
@@ -68,6 +73,7 @@ private:
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
 		Json::Value outputSelection;
+		bool profile = false;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
@@ -77,7 +83,13 @@ private:
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// @returns the canonical form of the input used as key into the compilation cache.
+	static std::string canonicalCacheInput(Json::Value const& _input, InputsAndSettings const& _inputsAndSettings);
+
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<CompilationCache> m_cache;
+	/// Hashes of the sources loaded through import statements during the last compilation.
+	std::map<std::string, h256> m_importedSources;
 };
 
 }
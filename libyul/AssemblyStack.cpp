@@ -30,6 +30,7 @@
 #include <libyul/backends/evm/EVMAssembly.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/backends/evm/EVMObjectCompiler.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Suite.h>
@@ -94,7 +95,7 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	solAssert(m_parserResult, "");
-	optimize(*m_parserResult);
+	optimize(*m_parserResult, true);
 	solAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -134,15 +135,21 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
 }
 
-void AssemblyStack::optimize(Object& _object)
+void AssemblyStack::optimize(Object& _object, bool _isCreation)
 {
 	solAssert(_object.code, "");
 	solAssert(_object.analysisInfo, "");
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject);
+			optimize(*subObject, false);
+
+	shared_ptr<Dialect> dialect = languageToDialect(m_language, m_evmVersion);
+	unique_ptr<GasMeter> meter;
+	if (auto evmDialect = dynamic_pointer_cast<EVMDialect>(dialect))
+		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
 	OptimiserSuite::run(
-		languageToDialect(m_language, m_evmVersion),
+		dialect,
+		meter.get(),
 		*_object.code,
 		*_object.analysisInfo,
 		m_optimiserSettings.optimizeStackAllocation
@@ -99,7 +99,8 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
-	void optimize(yul::Object& _object);
+	/// @param _isCreation true for the outermost object, which is assumed to be creation code.
+	void optimize(yul::Object& _object, bool _isCreation);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
@@ -65,6 +65,17 @@ public:
 		return Handle{id, h};
 	}
 	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+	/// @returns the number of strings in the repository, including the empty string.
+	size_t size() const { return m_strings.size(); }
+
+	/// Removes all strings apart from the empty string. This invalidates all existing
+	/// YulStrings, so it may only be called when none of them is used anymore, e.g. between
+	/// two inputs of a fuzzer. Because of that, YulStrings must not be stored in static variables.
+	void reset()
+	{
+		m_strings = {std::make_shared<std::string>()};
+		m_hashToID = {{emptyHash(), 0}};
+	}
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -117,6 +128,8 @@ public:
 	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
 
 	bool empty() const { return m_handle.id == 0; }
+	/// @returns the deterministic hash of the string.
+	std::uint64_t hash() const { return m_handle.hash; }
 	std::string const& str() const
 	{
 		return YulStringRepository::instance().idToString(m_handle.id);
@@ -20,6 +20,8 @@
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 
+#include <libyul/backends/evm/StackShuffler.h>
+
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmData.h>
@@ -159,6 +161,33 @@ void CodeTransform::freeUnusedVariables()
 	}
 }
 
+bool CodeTransform::consumeIfLastReference(YulString _name, Scope::Variable const& _var)
+{
+	if (!m_allowStackOpt || m_inForLoopCondition)
+		return false;
+	// Only variables of the current scope are removed right away, everything else
+	// has to stay until the end of its scope, since that might be inside a loop.
+	auto declaration = m_scope->identifiers.find(_name);
+	if (
+		declaration == m_scope->identifiers.end() ||
+		declaration->second.type() != typeid(Scope::Variable) ||
+		&boost::get<Scope::Variable>(declaration->second) != &_var
+	)
+		return false;
+	if (m_context->variableReferences.at(&_var) != 1)
+		return false;
+	if (m_assembly.stackHeight() - m_context->variableStackHeights.at(&_var) != 1)
+		return false;
+
+	// The variable is the top-most stack slot and this is its last reference,
+	// so the slot is re-used for the value of the expression instead of
+	// duplicating it and popping it later.
+	m_context->variableStackHeights.erase(&_var);
+	m_context->variableReferences.erase(&_var);
+	--m_stackAdjustment;
+	return true;
+}
+
 void CodeTransform::deleteVariable(Scope::Variable const& _var)
 {
 	solAssert(m_allowStackOpt, "");
@@ -174,11 +203,11 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 	solAssert(m_scope, "");
 
 	int const numVariables = _varDecl.variables.size();
-	int height = m_assembly.stackHeight();
 	if (_varDecl.value)
 	{
+		int heightBefore = logicalStackHeight();
 		boost::apply_visitor(*this, *_varDecl.value);
-		expectDeposit(numVariables, height);
+		expectDeposit(numVariables, heightBefore);
 	}
 	else
 	{
@@ -186,6 +215,9 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		while (variablesLeft--)
 			m_assembly.appendConstant(u256(0));
 	}
+	// The value might have re-used the stack slot of a variable that is not used anymore,
+	// so the height of the new variables is determined from the top of the stack.
+	int height = m_assembly.stackHeight() - numVariables;
 
 	bool atTopOfStack = true;
 	for (int varIndex = numVariables - 1; varIndex >= 0; --varIndex)
@@ -239,7 +271,7 @@ void CodeTransform::stackError(StackTooDeepError _error, int _targetStackHeight)
 
 void CodeTransform::operator()(Assignment const& _assignment)
 {
-	int height = m_assembly.stackHeight();
+	int height = logicalStackHeight();
 	boost::apply_visitor(*this, *_assignment.value);
 	expectDeposit(_assignment.variableNames.size(), height);
 
@@ -362,8 +394,8 @@ void CodeTransform::operator()(Identifier const& _identifier)
 	if (m_scope->lookup(_identifier.name, Scope::NonconstVisitor(
 		[=](Scope::Variable& _var)
 		{
-			// TODO: opportunity for optimization: Do not DUP if this is the last reference
-			// to the top most element of the stack
+			if (consumeIfLastReference(_identifier.name, _var))
+				return;
 			if (int heightDiff = variableHeightDiff(_var, _identifier.name, false))
 				m_assembly.appendInstruction(dev::eth::dupInstruction(heightDiff));
 			else
@@ -545,8 +577,8 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 		// <return values...> <return label>?
 		// So we have to append some SWAP and POP instructions.
 
-		// This vector holds the desired target positions of all stack slots and is
-		// modified parallel to the actual stack.
+		// This vector holds the desired target positions of all stack slots,
+		// the StackShuffler computes the cheapest way to get there.
 		vector<int> stackLayout;
 		if (!m_evm15)
 			stackLayout.push_back(_function.returnVariables.size()); // Move return label to the top
@@ -568,21 +600,8 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 			stackError(std::move(error), m_assembly.stackHeight() - _function.parameters.size());
 		}
 		else
-		{
-			while (!stackLayout.empty() && stackLayout.back() != int(stackLayout.size() - 1))
-				if (stackLayout.back() < 0)
-				{
-					m_assembly.appendInstruction(dev::eth::Instruction::POP);
-					stackLayout.pop_back();
-				}
-				else
-				{
-					m_assembly.appendInstruction(dev::eth::swapInstruction(stackLayout.size() - stackLayout.back() - 1));
-					swap(stackLayout[stackLayout.back()], stackLayout.back());
-				}
-			for (int i = 0; size_t(i) < stackLayout.size(); ++i)
-				solAssert(i == stackLayout[i], "Error reshuffling stack.");
-		}
+			for (auto instruction: StackShuffler::shuffle(stackLayout))
+				m_assembly.appendInstruction(instruction);
 	}
 	if (m_evm15)
 		m_assembly.appendReturnsub(_function.returnVariables.size(), stackHeightBefore);
@@ -609,7 +628,9 @@ void CodeTransform::operator()(ForLoop const& _forLoop)
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendLabel(loopStart);
 
+	m_inForLoopCondition = true;
 	visitExpression(*_forLoop.condition);
+	m_inForLoopCondition = false;
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendInstruction(dev::eth::Instruction::ISZERO);
 	m_assembly.appendJumpToIf(loopEnd);
@@ -717,7 +738,7 @@ AbstractAssembly::LabelID CodeTransform::functionEntryID(YulString _name, Scope:
 
 void CodeTransform::visitExpression(Expression const& _expression)
 {
-	int height = m_assembly.stackHeight();
+	int height = logicalStackHeight();
 	boost::apply_visitor(*this, _expression);
 	expectDeposit(1, height);
 }
@@ -810,14 +831,14 @@ int CodeTransform::variableHeightDiff(Scope::Variable const& _var, YulString _va
 
 void CodeTransform::expectDeposit(int _deposit, int _oldHeight) const
 {
-	solAssert(m_assembly.stackHeight() == _oldHeight + _deposit, "Invalid stack deposit.");
+	solAssert(logicalStackHeight() == _oldHeight + _deposit, "Invalid stack deposit.");
 }
 
 void CodeTransform::checkStackHeight(void const* _astElement) const
 {
 	solAssert(m_info.stackHeightInfo.count(_astElement), "Stack height for AST element not found.");
 	int stackHeightInAnalysis = m_info.stackHeightInfo.at(_astElement);
-	int stackHeightInCodegen = m_assembly.stackHeight() - m_stackAdjustment;
+	int stackHeightInCodegen = logicalStackHeight();
 	solAssert(
 		stackHeightInAnalysis == stackHeightInCodegen,
 		"Stack height mismatch between analysis and code generation phase: Analysis: " +
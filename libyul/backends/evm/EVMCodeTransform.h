@@ -166,6 +166,10 @@ protected:
 	void freeUnusedVariables();
 	/// Marks the stack slot of @a _var to be reused.
 	void deleteVariable(Scope::Variable const& _var);
+	/// Removes @a _var without generating code if it is the top-most stack slot and
+	/// this is its last reference, so that the slot can be used as the value of the reference.
+	/// @returns true if the variable was removed.
+	bool consumeIfLastReference(YulString _name, Scope::Variable const& _var);
 
 public:
 	void operator()(Instruction const& _instruction);
@@ -209,6 +213,10 @@ private:
 	/// the (positive) stack height difference otherwise.
 	int variableHeightDiff(Scope::Variable const& _var, YulString _name, bool _forSwap);
 
+	/// @returns the stack height without the adjustment, i.e. the stack height as seen by the
+	/// analysis phase. This does not change if a variable slot is re-used for an expression value.
+	int logicalStackHeight() const { return m_assembly.stackHeight() - m_stackAdjustment; }
+	/// Checks that the logical stack height increased by @a _deposit since @a _oldHeight.
 	void expectDeposit(int _deposit, int _oldHeight) const;
 
 	void checkStackHeight(void const* _astElement) const;
@@ -241,6 +249,8 @@ private:
 	/// statement level in the scope where the variable was defined.
 	std::set<Scope::Variable const*> m_variablesScheduledForDeletion;
 	std::set<int> m_unusedStackSlots;
+	/// True while visiting the condition of a for loop, which is evaluated repeatedly.
+	bool m_inForLoopCondition = false;
 
 	std::vector<StackTooDeepError> m_stackErrors;
 };
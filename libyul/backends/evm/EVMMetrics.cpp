@@ -0,0 +1,168 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Module providing metrics for the EVM optimizer.
+ */
+
+#include <libyul/backends/evm/EVMMetrics.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+namespace
+{
+
+/// Run gas of the code needed to call a user-defined function: Pushing the return label
+/// and the function label, jumping into and out of the function and the two JUMPDESTs.
+unsigned const functionCallRunGas = 2 * eth::GasCosts::tier2Gas + 2 * eth::GasCosts::tier4Gas + 2 * eth::GasCosts::jumpdestGas;
+/// Size of the code needed to call a user-defined function, assuming two-byte labels.
+unsigned const functionCallBytes = 2 * 3 + 2 + 2;
+
+/**
+ * Sums up the run gas and the code size of an expression.
+ */
+class GasMeterVisitor: public ASTWalker
+{
+public:
+	explicit GasMeterVisitor(EVMDialect const& _dialect): m_dialect(_dialect) {}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		if (m_dialect.builtin(_funCall.functionName.name))
+		{
+			// datasize and dataoffset push a constant, datacopy is a codecopy.
+			if (_funCall.functionName.name == "datacopy"_yulstring)
+				instruction(eth::Instruction::CODECOPY);
+			else
+			{
+				m_runGas += eth::GasCosts::tier2Gas;
+				m_bytes += 1 + 4;
+			}
+		}
+		else
+		{
+			m_runGas += functionCallRunGas;
+			m_bytes += functionCallBytes;
+		}
+	}
+	void operator()(FunctionalInstruction const& _instr) override
+	{
+		ASTWalker::operator()(_instr);
+		instruction(_instr.instruction);
+	}
+	void operator()(Literal const& _literal) override
+	{
+		m_runGas += eth::GasCosts::tier2Gas;
+		m_bytes += 1 + max<size_t>(1, bytesRequired(valueOfLiteral(_literal)));
+	}
+	void operator()(Identifier const&) override
+	{
+		instruction(eth::Instruction::DUP1);
+	}
+
+	void instruction(eth::Instruction _instruction)
+	{
+		m_runGas += runGas(_instruction);
+		m_bytes += 1;
+	}
+
+	bigint runGas(eth::Instruction _instruction) const
+	{
+		langutil::EVMVersion const version = m_dialect.evmVersion();
+		switch (_instruction)
+		{
+		case eth::Instruction::EXP:
+			return eth::GasCosts::expGas + eth::GasCosts::expByteGas(version);
+		case eth::Instruction::KECCAK256:
+			return eth::GasCosts::keccak256Gas + eth::GasCosts::keccak256WordGas;
+		case eth::Instruction::BALANCE:
+		case eth::Instruction::EXTCODEHASH:
+			return eth::GasCosts::balanceGas(version);
+		case eth::Instruction::EXTCODESIZE:
+		case eth::Instruction::EXTCODECOPY:
+			return eth::GasCosts::extCodeGas(version);
+		case eth::Instruction::SLOAD:
+			return eth::GasCosts::sloadGas(version);
+		case eth::Instruction::SSTORE:
+			return eth::GasCosts::sstoreResetGas;
+		case eth::Instruction::JUMPDEST:
+			return eth::GasCosts::jumpdestGas;
+		case eth::Instruction::LOG0:
+		case eth::Instruction::LOG1:
+		case eth::Instruction::LOG2:
+		case eth::Instruction::LOG3:
+		case eth::Instruction::LOG4:
+			return eth::GasCosts::logGas + eth::GasCosts::logTopicGas * eth::getLogNumber(_instruction);
+		case eth::Instruction::CREATE:
+		case eth::Instruction::CREATE2:
+			return eth::GasCosts::createGas;
+		case eth::Instruction::CALL:
+		case eth::Instruction::CALLCODE:
+		case eth::Instruction::DELEGATECALL:
+		case eth::Instruction::STATICCALL:
+			return eth::GasCosts::callGas(version);
+		case eth::Instruction::SELFDESTRUCT:
+			return eth::GasCosts::selfdestructGas(version);
+		default:
+			return eth::GasMeter::runGas(_instruction);
+		}
+	}
+
+	bigint m_runGas = 0;
+	bigint m_bytes = 0;
+
+private:
+	EVMDialect const& m_dialect;
+};
+
+}
+
+bigint GasMeter::costs(Expression const& _expression) const
+{
+	GasMeterVisitor visitor(m_dialect);
+	visitor.visit(_expression);
+	return combine({visitor.m_runGas, visitor.m_bytes});
+}
+
+bigint GasMeter::instructionCosts(eth::Instruction _instruction) const
+{
+	GasMeterVisitor visitor(m_dialect);
+	visitor.instruction(_instruction);
+	return combine({visitor.m_runGas, visitor.m_bytes});
+}
+
+bigint GasMeter::dataCosts(bigint const& _bytes) const
+{
+	return eth::GasMeter::dataGas(_bytes, m_isCreation);
+}
+
+bigint GasMeter::combine(pair<bigint, bigint> const& _runGasAndBytes) const
+{
+	return _runGasAndBytes.first * m_runs + dataCosts(_runGasAndBytes.second);
+}
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Module providing metrics for the EVM optimizer.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libdevcore/Common.h>
+
+namespace yul
+{
+struct EVMDialect;
+
+/**
+ * Gas meter for expressions that combines the gas costs for executing code with
+ * the costs for deploying it, in the same way as the constant optimiser of the
+ * evmasm optimiser: The costs are the run gas times the expected number of executions
+ * plus the gas for storing the code in the state (or for the transaction data
+ * in the case of creation code).
+ *
+ * The run gas of instructions depends on the EVM version of the dialect. Costs that
+ * depend on the arguments (memory expansion, number of words, the exponent of EXP,
+ * zero or non-zero storage values) are not taken into account, apart from assuming a
+ * single word for KECCAK256 and a single byte exponent for EXP.
+ * Variable references are assumed to cost a DUP, calls to user-defined functions
+ * the jumps and tags needed for a call, but not the body of the function.
+ */
+class GasMeter
+{
+public:
+	GasMeter(EVMDialect const& _dialect, bool _isCreation, size_t _runs):
+		m_dialect(_dialect),
+		m_isCreation{_isCreation},
+		m_runs(_isCreation ? 1 : _runs)
+	{}
+
+	/// @returns the full combined costs of deploying and evaluating the expression.
+	dev::bigint costs(Expression const& _expression) const;
+	/// @returns the combined costs of deploying and running the instruction, not including
+	/// the costs for its arguments.
+	dev::bigint instructionCosts(dev::eth::Instruction _instruction) const;
+	/// @returns the costs of deploying @a _bytes bytes of code.
+	dev::bigint dataCosts(dev::bigint const& _bytes) const;
+
+	/// @returns the expected number of executions of the code.
+	size_t runs() const { return m_runs; }
+
+private:
+	dev::bigint combine(std::pair<dev::bigint, dev::bigint> const& _runGasAndBytes) const;
+
+	EVMDialect const& m_dialect;
+	bool m_isCreation = false;
+	size_t m_runs;
+};
+
+}
@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Computes SWAP and POP sequences that bring the stack into a desired layout.
+ */
+
+#include <libyul/backends/evm/StackShuffler.h>
+
+#include <libyul/Exceptions.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <functional>
+#include <map>
+#include <queue>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+size_t constexpr StackShuffler::maxSearchSize;
+
+vector<eth::Instruction> StackShuffler::shuffle(vector<int> const& _layout)
+{
+	vector<eth::Instruction> instructions = greedy(_layout);
+	if (_layout.size() <= maxSearchSize)
+	{
+		// Only deviate from the greedy solution if it is actually cheaper.
+		vector<eth::Instruction> optimal = search(_layout);
+		if (cost(optimal) < cost(instructions))
+			return optimal;
+	}
+	return instructions;
+}
+
+vector<eth::Instruction> StackShuffler::search(vector<int> const& _layout)
+{
+	// Dijkstra's algorithm on the graph of stack layouts, where the edges are the
+	// SWAP and POP instructions weighted by their gas costs.
+	using Layout = vector<int>;
+	map<Layout, unsigned> costs;
+	map<Layout, pair<Layout, eth::Instruction>> predecessors;
+	priority_queue<pair<unsigned, Layout>, vector<pair<unsigned, Layout>>, greater<pair<unsigned, Layout>>> queue;
+
+	unsigned const swapCost = cost({eth::Instruction::SWAP1});
+	unsigned const popCost = cost({eth::Instruction::POP});
+
+	auto relax = [&](Layout const& _from, unsigned _cost, Layout&& _to, eth::Instruction _instruction)
+	{
+		auto it = costs.find(_to);
+		if (it != costs.end() && it->second <= _cost)
+			return;
+		costs[_to] = _cost;
+		predecessors[_to] = make_pair(_from, _instruction);
+		queue.emplace(_cost, move(_to));
+	};
+
+	costs[_layout] = 0;
+	queue.emplace(0, _layout);
+	while (!queue.empty())
+	{
+		unsigned cost = queue.top().first;
+		Layout layout = queue.top().second;
+		queue.pop();
+		if (cost > costs.at(layout))
+			continue;
+
+		if (isTarget(layout))
+		{
+			vector<eth::Instruction> instructions;
+			while (layout != _layout)
+			{
+				auto const& predecessor = predecessors.at(layout);
+				instructions.push_back(predecessor.second);
+				layout = predecessor.first;
+			}
+			return vector<eth::Instruction>(instructions.rbegin(), instructions.rend());
+		}
+
+		if (layout.back() < 0)
+			relax(layout, cost + popCost, Layout(layout.begin(), layout.end() - 1), eth::Instruction::POP);
+		for (size_t depth = 1; depth < layout.size() && depth <= 16; ++depth)
+		{
+			Layout next = layout;
+			swap(next.back(), next[next.size() - 1 - depth]);
+			relax(layout, cost + swapCost, move(next), eth::swapInstruction(depth));
+		}
+	}
+	yulAssert(false, "Stack layout not reachable.");
+	return {};
+}
+
+vector<eth::Instruction> StackShuffler::greedy(vector<int> _layout)
+{
+	vector<eth::Instruction> instructions;
+	while (!isTarget(_layout))
+		if (_layout.back() < 0)
+		{
+			instructions.push_back(eth::Instruction::POP);
+			_layout.pop_back();
+		}
+		else if (_layout.back() != int(_layout.size() - 1))
+		{
+			instructions.push_back(eth::swapInstruction(_layout.size() - _layout.back() - 1));
+			swap(_layout[_layout.back()], _layout.back());
+		}
+		else
+		{
+			// The top-most slot is already in place, so start a new cycle by
+			// exchanging it with the deepest slot that is not.
+			size_t position = 0;
+			while (_layout[position] == int(position))
+				++position;
+			instructions.push_back(eth::swapInstruction(_layout.size() - position - 1));
+			swap(_layout[position], _layout.back());
+		}
+	return instructions;
+}
+
+bool StackShuffler::isTarget(vector<int> const& _layout)
+{
+	for (size_t i = 0; i < _layout.size(); ++i)
+		if (_layout[i] != int(i))
+			return false;
+	return true;
+}
+
+unsigned StackShuffler::cost(vector<eth::Instruction> const& _instructions)
+{
+	unsigned gas = 0;
+	for (auto instruction: _instructions)
+		gas += eth::GasMeter::runGas(instruction);
+	return gas;
+}
@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Computes SWAP and POP sequences that bring the stack into a desired layout.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <vector>
+
+namespace yul
+{
+
+/**
+ * Computes a sequence of SWAP and POP instructions that transforms the stack into
+ * a target layout.
+ *
+ * The layout is given as a vector with one entry per stack slot, starting at the
+ * bottom-most slot that is affected. Each entry is the position of the slot in the
+ * target layout or -1 if the slot is to be removed. The non-negative entries have to
+ * be a permutation of 0, ..., n - 1.
+ *
+ * The basic algorithm is greedy: It moves the top-most slot to its target position
+ * until the layout is reached. For small layouts, the cheapest sequence in terms of gas
+ * is found by a shortest-path search over all reachable layouts and used instead if it
+ * is cheaper than the greedy one.
+ */
+class StackShuffler
+{
+public:
+	/// Layouts of at most this size are shuffled optimally.
+	static size_t constexpr maxSearchSize = 6;
+
+	static std::vector<dev::eth::Instruction> shuffle(std::vector<int> const& _layout);
+
+private:
+	static std::vector<dev::eth::Instruction> search(std::vector<int> const& _layout);
+	static std::vector<dev::eth::Instruction> greedy(std::vector<int> _layout);
+	static bool isTarget(std::vector<int> const& _layout);
+	/// @returns the gas costs of @a _instructions.
+	static unsigned cost(std::vector<dev::eth::Instruction> const& _instructions);
+};
+
+}
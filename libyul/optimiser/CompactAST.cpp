@@ -0,0 +1,425 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Index-based representation of a Yul AST for the optimiser.
+ */
+
+#include <libyul/optimiser/CompactAST.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/CommonData.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+/**
+ * Appends the nodes of a regular AST.
+ */
+class CompactAST::Builder: public boost::static_visitor<CompactAST::NodeID>
+{
+public:
+	explicit Builder(CompactAST& _ast): m_ast(_ast) {}
+
+	NodeID operator()(Literal const& _literal)
+	{
+		NodeID id = m_ast.addNode(Kind::Literal, {});
+		m_ast.m_nodes[id].data = uint32_t(_literal.kind);
+		m_ast.m_nodes[id].name = _literal.value;
+		m_ast.m_nodes[id].type = _literal.type;
+		return id;
+	}
+	NodeID operator()(Identifier const& _identifier)
+	{
+		NodeID id = m_ast.addNode(Kind::Identifier, {});
+		m_ast.m_nodes[id].name = _identifier.name;
+		return id;
+	}
+	NodeID operator()(FunctionalInstruction const& _instr)
+	{
+		NodeID id = m_ast.addNode(Kind::FunctionalInstruction, expressions(_instr.arguments));
+		m_ast.m_nodes[id].data = uint32_t(_instr.instruction);
+		return id;
+	}
+	NodeID operator()(FunctionCall const& _funCall)
+	{
+		vector<NodeID> children{(*this)(_funCall.functionName)};
+		for (auto const& argument: _funCall.arguments)
+			children.push_back(boost::apply_visitor(*this, argument));
+		return m_ast.addNode(Kind::FunctionCall, children);
+	}
+	NodeID operator()(ExpressionStatement const& _statement)
+	{
+		return m_ast.addNode(Kind::ExpressionStatement, {boost::apply_visitor(*this, _statement.expression)});
+	}
+	NodeID operator()(Assignment const& _assignment)
+	{
+		yulAssert(_assignment.value, "");
+		vector<NodeID> children;
+		for (auto const& variableName: _assignment.variableNames)
+			children.push_back((*this)(variableName));
+		children.push_back(boost::apply_visitor(*this, *_assignment.value));
+		return m_ast.addNode(Kind::Assignment, children);
+	}
+	NodeID operator()(VariableDeclaration const& _varDecl)
+	{
+		vector<NodeID> children = typedNames(_varDecl.variables);
+		if (_varDecl.value)
+			children.push_back(boost::apply_visitor(*this, *_varDecl.value));
+		NodeID id = m_ast.addNode(Kind::VariableDeclaration, children);
+		m_ast.m_nodes[id].data = _varDecl.value ? 1 : 0;
+		return id;
+	}
+	NodeID operator()(FunctionDefinition const& _function)
+	{
+		vector<NodeID> children = typedNames(_function.parameters);
+		for (NodeID returnVariable: typedNames(_function.returnVariables))
+			children.push_back(returnVariable);
+		children.push_back((*this)(_function.body));
+		NodeID id = m_ast.addNode(Kind::FunctionDefinition, children);
+		m_ast.m_nodes[id].data = uint32_t(_function.parameters.size());
+		m_ast.m_nodes[id].name = _function.name;
+		return id;
+	}
+	NodeID operator()(If const& _if)
+	{
+		yulAssert(_if.condition, "");
+		return m_ast.addNode(Kind::If, {boost::apply_visitor(*this, *_if.condition), (*this)(_if.body)});
+	}
+	NodeID operator()(Switch const& _switch)
+	{
+		yulAssert(_switch.expression, "");
+		vector<NodeID> children{boost::apply_visitor(*this, *_switch.expression)};
+		for (auto const& switchCase: _switch.cases)
+		{
+			vector<NodeID> caseChildren;
+			if (switchCase.value)
+				caseChildren.push_back((*this)(*switchCase.value));
+			caseChildren.push_back((*this)(switchCase.body));
+			children.push_back(m_ast.addNode(Kind::Case, caseChildren));
+		}
+		return m_ast.addNode(Kind::Switch, children);
+	}
+	NodeID operator()(ForLoop const& _forLoop)
+	{
+		yulAssert(_forLoop.condition, "");
+		vector<NodeID> children{(*this)(_forLoop.pre)};
+		children.push_back(boost::apply_visitor(*this, *_forLoop.condition));
+		children.push_back((*this)(_forLoop.post));
+		children.push_back((*this)(_forLoop.body));
+		return m_ast.addNode(Kind::ForLoop, children);
+	}
+	NodeID operator()(Break const&)
+	{
+		return m_ast.addNode(Kind::Break, {});
+	}
+	NodeID operator()(Continue const&)
+	{
+		return m_ast.addNode(Kind::Continue, {});
+	}
+	NodeID operator()(Block const& _block)
+	{
+		vector<NodeID> children;
+		for (auto const& statement: _block.statements)
+			children.push_back(boost::apply_visitor(*this, statement));
+		return m_ast.addNode(Kind::Block, children);
+	}
+	NodeID operator()(Instruction const&)
+	{
+		assertThrow(false, OptimizerException, "Invalid operation.");
+		return 0;
+	}
+	NodeID operator()(Label const&)
+	{
+		assertThrow(false, OptimizerException, "Invalid operation.");
+		return 0;
+	}
+	NodeID operator()(StackAssignment const&)
+	{
+		assertThrow(false, OptimizerException, "Invalid operation.");
+		return 0;
+	}
+
+private:
+	vector<NodeID> expressions(vector<Expression> const& _expressions)
+	{
+		vector<NodeID> ids;
+		for (auto const& expression: _expressions)
+			ids.push_back(boost::apply_visitor(*this, expression));
+		return ids;
+	}
+	vector<NodeID> typedNames(TypedNameList const& _names)
+	{
+		vector<NodeID> ids;
+		for (auto const& typedName: _names)
+		{
+			NodeID id = m_ast.addNode(Kind::TypedName, {});
+			m_ast.m_nodes[id].name = typedName.name;
+			m_ast.m_nodes[id].type = typedName.type;
+			ids.push_back(id);
+		}
+		return ids;
+	}
+
+	CompactAST& m_ast;
+};
+
+/**
+ * Compares subtrees the way SyntacticallyEqual compares regular ASTs: Variables declared
+ * at the same position in both subtrees are considered equal.
+ */
+class CompactAST::Comparator
+{
+public:
+	explicit Comparator(CompactAST const& _ast): m_ast(_ast) {}
+
+	bool equal(NodeID _lhs, NodeID _rhs)
+	{
+		Node const& lhs = m_ast.m_nodes[_lhs];
+		Node const& rhs = m_ast.m_nodes[_rhs];
+		if (lhs.kind != rhs.kind)
+			return false;
+		switch (lhs.kind)
+		{
+		case Kind::Literal:
+			return literalsEqual(lhs, rhs);
+		case Kind::Identifier:
+		{
+			auto lhsIt = m_identifiersLHS.find(lhs.name);
+			auto rhsIt = m_identifiersRHS.find(rhs.name);
+			return
+				(lhsIt == m_identifiersLHS.end() && rhsIt == m_identifiersRHS.end() && lhs.name == rhs.name) ||
+				(lhsIt != m_identifiersLHS.end() && rhsIt != m_identifiersRHS.end() && lhsIt->second == rhsIt->second);
+		}
+		case Kind::TypedName:
+			if (lhs.type != rhs.type)
+				return false;
+			m_identifiersLHS[lhs.name] = m_idsUsed;
+			m_identifiersRHS[rhs.name] = m_idsUsed;
+			m_idsUsed++;
+			return true;
+		case Kind::VariableDeclaration:
+			// First visit the value, then the declarations.
+			if (lhs.data != rhs.data || lhs.childCount != rhs.childCount)
+				return false;
+			if (lhs.data && !equal(m_ast.child(_lhs, lhs.childCount - 1), m_ast.child(_rhs, rhs.childCount - 1)))
+				return false;
+			return childrenEqual(_lhs, _rhs, 0, lhs.childCount - lhs.data);
+		case Kind::FunctionDefinition:
+			// The name of the function is not compared.
+			return lhs.data == rhs.data && lhs.childCount == rhs.childCount && childrenEqual(_lhs, _rhs, 0, lhs.childCount);
+		case Kind::Switch:
+		{
+			if (lhs.childCount != rhs.childCount || !equal(m_ast.child(_lhs, 0), m_ast.child(_rhs, 0)))
+				return false;
+			vector<NodeID> lhsCases = m_ast.sortedCases(_lhs);
+			vector<NodeID> rhsCases = m_ast.sortedCases(_rhs);
+			for (size_t i = 0; i < lhsCases.size(); ++i)
+				if (!equal(lhsCases[i], rhsCases[i]))
+					return false;
+			return true;
+		}
+		case Kind::ForLoop:
+			// The body is visited before the post block.
+			return
+				equal(m_ast.child(_lhs, 0), m_ast.child(_rhs, 0)) &&
+				equal(m_ast.child(_lhs, 1), m_ast.child(_rhs, 1)) &&
+				equal(m_ast.child(_lhs, 3), m_ast.child(_rhs, 3)) &&
+				equal(m_ast.child(_lhs, 2), m_ast.child(_rhs, 2));
+		case Kind::FunctionalInstruction:
+			if (lhs.data != rhs.data)
+				return false;
+			return lhs.childCount == rhs.childCount && childrenEqual(_lhs, _rhs, 0, lhs.childCount);
+		case Kind::FunctionCall:
+		case Kind::ExpressionStatement:
+		case Kind::Assignment:
+		case Kind::If:
+		case Kind::Case:
+		case Kind::Break:
+		case Kind::Continue:
+		case Kind::Block:
+			return lhs.childCount == rhs.childCount && childrenEqual(_lhs, _rhs, 0, lhs.childCount);
+		}
+		yulAssert(false, "");
+		return false;
+	}
+
+private:
+	static bool literalsEqual(Node const& _lhs, Node const& _rhs)
+	{
+		if (_lhs.data != _rhs.data || _lhs.type != _rhs.type)
+			return false;
+		if (LiteralKind(_lhs.data) == LiteralKind::Number)
+			return u256(_lhs.name.str()) == u256(_rhs.name.str());
+		else
+			return _lhs.name == _rhs.name;
+	}
+
+	bool childrenEqual(NodeID _lhs, NodeID _rhs, size_t _begin, size_t _end)
+	{
+		for (size_t i = _begin; i < _end; ++i)
+			if (!equal(m_ast.child(_lhs, i), m_ast.child(_rhs, i)))
+				return false;
+		return true;
+	}
+
+	CompactAST const& m_ast;
+	map<YulString, size_t> m_identifiersLHS;
+	map<YulString, size_t> m_identifiersRHS;
+	size_t m_idsUsed = 0;
+};
+
+/**
+ * Hashes subtrees consistently with the comparator, i.e. declared variables are hashed by
+ * the order of their declaration and the nodes are visited in the same order.
+ */
+class CompactAST::Hasher
+{
+public:
+	explicit Hasher(CompactAST const& _ast): m_ast(_ast) {}
+
+	void hash(NodeID _node)
+	{
+		Node const& node = m_ast.m_nodes[_node];
+		combine(size_t(node.kind));
+		switch (node.kind)
+		{
+		case Kind::Literal:
+			combine(node.data);
+			combine(node.type.hash());
+			if (LiteralKind(node.data) == LiteralKind::Number)
+				combine(size_t(u256(node.name.str()) & u256(numeric_limits<size_t>::max())));
+			else
+				combine(node.name.hash());
+			return;
+		case Kind::Identifier:
+			if (m_declarations.count(node.name))
+				combine(m_declarations[node.name]);
+			else
+				combine(node.name.hash());
+			return;
+		case Kind::TypedName:
+			combine(node.type.hash());
+			m_declarations[node.name] = m_declarationCount++;
+			return;
+		case Kind::VariableDeclaration:
+			combine(node.childCount);
+			if (node.data)
+				hash(m_ast.child(_node, node.childCount - 1));
+			for (size_t i = 0; i < node.childCount - node.data; ++i)
+				hash(m_ast.child(_node, i));
+			return;
+		case Kind::Switch:
+			combine(node.childCount);
+			hash(m_ast.child(_node, 0));
+			for (NodeID switchCase: m_ast.sortedCases(_node))
+				hash(switchCase);
+			return;
+		case Kind::ForLoop:
+			for (size_t i: {0, 1, 3, 2})
+				hash(m_ast.child(_node, i));
+			return;
+		case Kind::FunctionDefinition:
+		case Kind::FunctionalInstruction:
+			combine(node.data);
+			break;
+		default:
+			break;
+		}
+		combine(node.childCount);
+		for (size_t i = 0; i < node.childCount; ++i)
+			hash(m_ast.child(_node, i));
+	}
+
+	size_t value() const { return m_value; }
+
+private:
+	void combine(size_t _value) { boost::hash_combine(m_value, _value); }
+
+	CompactAST const& m_ast;
+	map<YulString, size_t> m_declarations;
+	size_t m_declarationCount = 0;
+	size_t m_value = 0;
+};
+
+CompactAST::NodeID CompactAST::append(FunctionDefinition const& _function)
+{
+	return Builder{*this}(_function);
+}
+
+CompactAST::NodeID CompactAST::append(Statement const& _statement)
+{
+	Builder builder{*this};
+	return boost::apply_visitor(builder, _statement);
+}
+
+bool CompactAST::equal(NodeID _lhs, NodeID _rhs) const
+{
+	return Comparator{*this}.equal(_lhs, _rhs);
+}
+
+size_t CompactAST::hash(NodeID _node) const
+{
+	Hasher hasher{*this};
+	hasher.hash(_node);
+	return hasher.value();
+}
+
+vector<CompactAST::NodeID> CompactAST::sortedCases(NodeID _node) const
+{
+	Node const& node = m_nodes[_node];
+	yulAssert(node.kind == Kind::Switch, "");
+	vector<NodeID> cases;
+	for (size_t i = 1; i < node.childCount; ++i)
+		cases.push_back(child(_node, i));
+	stable_sort(cases.begin(), cases.end(), [&](NodeID _lhs, NodeID _rhs) {
+		bool lhsDefault = m_nodes[_lhs].childCount == 1;
+		bool rhsDefault = m_nodes[_rhs].childCount == 1;
+		if (lhsDefault || rhsDefault)
+			return lhsDefault && !rhsDefault;
+		Node const& lhs = m_nodes[child(_lhs, 0)];
+		Node const& rhs = m_nodes[child(_rhs, 0)];
+		if (make_tuple(lhs.data, lhs.type) != make_tuple(rhs.data, rhs.type))
+			return make_tuple(lhs.data, lhs.type) < make_tuple(rhs.data, rhs.type);
+		if (LiteralKind(lhs.data) == LiteralKind::Number)
+			return u256(lhs.name.str()) < u256(rhs.name.str());
+		else
+			return lhs.name < rhs.name;
+	});
+	return cases;
+}
+
+CompactAST::NodeID CompactAST::addNode(Kind _kind, vector<NodeID> const& _children)
+{
+	m_nodes.push_back(Node{
+		_kind,
+		0,
+		uint32_t(m_children.size()),
+		uint32_t(_children.size()),
+		{},
+		{}
+	});
+	m_children += _children;
+	return NodeID(m_nodes.size() - 1);
+}
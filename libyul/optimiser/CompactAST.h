@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Index-based representation of a Yul AST for the optimiser.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace yul
+{
+
+/**
+ * Compact representation of Yul code for optimiser components that mostly read it.
+ *
+ * All nodes are stored in a single array and refer to their children by index,
+ * so that a tree does not need an allocation per node and can be traversed without
+ * chasing pointers. Source locations are not stored.
+ *
+ * Instructions, labels and stack assignments are not supported.
+ */
+class CompactAST
+{
+public:
+	using NodeID = std::uint32_t;
+
+	/// Appends the given code. @returns the ID of its root node.
+	NodeID append(FunctionDefinition const& _function);
+	NodeID append(Statement const& _statement);
+
+	/// @returns true if the two subtrees are equal apart from source locations and
+	/// the names of the variables declared in them, like SyntacticallyEqual.
+	bool equal(NodeID _lhs, NodeID _rhs) const;
+	/// @returns a hash of the subtree that is identical for subtrees that are equal
+	/// according to @a equal.
+	std::size_t hash(NodeID _node) const;
+
+private:
+	enum class Kind: std::uint8_t
+	{
+		Literal,
+		Identifier,
+		FunctionalInstruction,
+		FunctionCall,
+		ExpressionStatement,
+		Assignment,
+		VariableDeclaration,
+		FunctionDefinition,
+		If,
+		Switch,
+		Case,
+		ForLoop,
+		Break,
+		Continue,
+		Block,
+		TypedName
+	};
+
+	/// Node of the tree. Its children are the entries of the children array starting
+	/// at @a childrenBegin, in the following order:
+	///  - FunctionalInstruction: arguments
+	///  - FunctionCall: function name (an identifier), arguments
+	///  - ExpressionStatement: expression
+	///  - Assignment: variable names (identifiers), value
+	///  - VariableDeclaration: variables (typed names), value if @a data is non-zero
+	///  - FunctionDefinition: @a data parameters (typed names), return variables (typed names), body
+	///  - If: condition, body
+	///  - Switch: expression, cases
+	///  - Case: value unless it is the default case, body
+	///  - ForLoop: pre, condition, post, body
+	///  - Block: statements
+	struct Node
+	{
+		Kind kind;
+		/// Kind of a literal, instruction of a functional instruction, number of parameters
+		/// of a function or whether a variable declaration has a value.
+		std::uint32_t data;
+		std::uint32_t childrenBegin;
+		std::uint32_t childCount;
+		/// Value of a literal, name of an identifier, a typed name or a function.
+		YulString name;
+		/// Type of a literal or a typed name.
+		YulString type;
+	};
+
+	class Builder;
+	class Comparator;
+	class Hasher;
+
+	Node const& node(NodeID _node) const { return m_nodes[_node]; }
+	/// @returns the ID of the @a _index-th child of @a _node.
+	NodeID child(NodeID _node, size_t _index) const { return m_children[m_nodes[_node].childrenBegin + _index]; }
+	/// @returns the cases of the switch at @a _node, with the default case first
+	/// and the others ordered by their value.
+	std::vector<NodeID> sortedCases(NodeID _node) const;
+
+	NodeID addNode(Kind _kind, std::vector<NodeID> const& _children);
+
+	std::vector<Node> m_nodes;
+	std::vector<NodeID> m_children;
+};
+
+}
@@ -26,21 +26,96 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
 
 #include <libdevcore/CommonData.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <cctype>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
 
+namespace
+{
+
+bool isLiteral(YulString _operand)
+{
+	return !_operand.empty() && isdigit(_operand.str().front());
+}
+
+/// @returns true if the two operands are literals whose values differ by at least @a _distance.
+bool knownToBeDifferent(YulString _a, YulString _b, u256 const& _distance)
+{
+	if (!isLiteral(_a) || !isLiteral(_b))
+		return false;
+	u256 a(_a.str());
+	u256 b(_b.str());
+	return (a > b ? a - b : b - a) >= _distance;
+}
+
+/// Removes the entries of @a _knowledge whose location might overlap with a write
+/// of @a _size bytes at @a _key.
+void invalidateOverlapping(map<YulString, YulString>& _knowledge, YulString _key, u256 const& _size)
+{
+	for (auto it = _knowledge.begin(); it != _knowledge.end();)
+		if (knownToBeDifferent(it->first, _key, _size))
+			++it;
+		else
+			it = _knowledge.erase(it);
+}
+
+/// Removes the entries of @a _knowledge that are not also present in @a _older.
+void intersect(map<YulString, YulString>& _knowledge, map<YulString, YulString> const& _older)
+{
+	for (auto it = _knowledge.begin(); it != _knowledge.end();)
+	{
+		auto older = _older.find(it->first);
+		if (older != _older.end() && older->second == it->second)
+			++it;
+		else
+			it = _knowledge.erase(it);
+	}
+}
+
+}
+
+void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
+{
+	if (_statement.expression.type() == typeid(FunctionalInstruction))
+	{
+		auto const& instruction = boost::get<FunctionalInstruction>(_statement.expression);
+		bool const isStorage = instruction.instruction == eth::Instruction::SSTORE;
+		if (isStorage || instruction.instruction == eth::Instruction::MSTORE)
+		{
+			assertThrow(instruction.arguments.size() == 2, OptimizerException, "");
+			// The arguments are visited first, they cannot access storage or memory
+			// if both are variables or literals.
+			boost::optional<YulString> key = storeOperand(instruction.arguments[0]);
+			boost::optional<YulString> value = storeOperand(instruction.arguments[1]);
+			if (key && value)
+			{
+				ASTModifier::operator()(_statement);
+				auto& knowledge = isStorage ? m_storage : m_memory;
+				invalidateOverlapping(knowledge, *key, isStorage ? 1 : 32);
+				knowledge[*key] = *value;
+				return;
+			}
+		}
+	}
+	clearKnowledgeIfInvalidated(_statement.expression);
+	ASTModifier::operator()(_statement);
+}
+
 void DataFlowAnalyzer::operator()(Assignment& _assignment)
 {
 	set<YulString> names;
 	for (auto const& var: _assignment.variableNames)
 		names.emplace(var.name);
 	assertThrow(_assignment.value, OptimizerException, "");
+	clearKnowledgeIfInvalidated(*_assignment.value);
 	visit(*_assignment.value);
 	handleAssignment(names, _assignment.value.get());
 }
@@ -53,15 +128,24 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 	m_variableScopes.back().variables += names;
 
 	if (_varDecl.value)
+	{
+		clearKnowledgeIfInvalidated(*_varDecl.value);
 		visit(*_varDecl.value);
+	}
 
 	handleAssignment(names, _varDecl.value.get());
 }
 
 void DataFlowAnalyzer::operator()(If& _if)
 {
+	clearKnowledgeIfInvalidated(*_if.condition);
+	map<YulString, YulString> storage = m_storage;
+	map<YulString, YulString> memory = m_memory;
+
 	ASTModifier::operator()(_if);
 
+	joinKnowledge(storage, memory);
+
 	Assignments assignments;
 	assignments(_if.body);
 	clearValues(assignments.names());
@@ -69,16 +153,28 @@ void DataFlowAnalyzer::operator()(If& _if)
 
 void DataFlowAnalyzer::operator()(Switch& _switch)
 {
+	clearKnowledgeIfInvalidated(*_switch.expression);
 	visit(*_switch.expression);
 	set<YulString> assignedVariables;
+	// The knowledge before the switch is kept as one of the paths
+	// in case there is no default case.
+	map<YulString, YulString> const storage = m_storage;
+	map<YulString, YulString> const memory = m_memory;
+	map<YulString, YulString> joinedStorage = storage;
+	map<YulString, YulString> joinedMemory = memory;
 	for (auto& _case: _switch.cases)
 	{
+		m_storage = storage;
+		m_memory = memory;
 		(*this)(_case.body);
 		Assignments assignments;
 		assignments(_case.body);
 		assignedVariables += assignments.names();
 		// This is a little too destructive, we could retain the old values.
 		clearValues(assignments.names());
+		joinKnowledge(joinedStorage, joinedMemory);
+		joinedStorage = m_storage;
+		joinedMemory = m_memory;
 	}
 	clearValues(assignedVariables);
 }
@@ -90,9 +186,13 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	map<YulString, Expression const*> value;
 	map<YulString, set<YulString>> references;
 	map<YulString, set<YulString>> referencedBy;
+	map<YulString, YulString> storage;
+	map<YulString, YulString> memory;
 	m_value.swap(value);
 	m_references.swap(references);
 	m_referencedBy.swap(referencedBy);
+	m_storage.swap(storage);
+	m_memory.swap(memory);
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -108,6 +208,8 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	m_value.swap(value);
 	m_references.swap(references);
 	m_referencedBy.swap(referencedBy);
+	m_storage.swap(storage);
+	m_memory.swap(memory);
 }
 
 void DataFlowAnalyzer::operator()(ForLoop& _for)
@@ -124,10 +226,22 @@ void DataFlowAnalyzer::operator()(ForLoop& _for)
 	assignments(_for.post);
 	clearValues(assignments.names());
 
+	// Knowledge from before the loop is only kept if it holds in every iteration.
+	// Knowledge gained inside the loop is discarded afterwards since the body
+	// might not be executed at all.
+	clearKnowledgeIfInvalidated(*_for.condition);
+	clearKnowledgeIfInvalidated(_for.body);
+	clearKnowledgeIfInvalidated(_for.post);
+	map<YulString, YulString> storage = m_storage;
+	map<YulString, YulString> memory = m_memory;
+
 	visit(*_for.condition);
 	(*this)(_for.body);
 	clearValues(assignmentsSinceCont.names());
 	(*this)(_for.post);
+
+	m_storage = move(storage);
+	m_memory = move(memory);
 	clearValues(assignments.names());
 }
 
@@ -142,7 +256,6 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expression* _value)
 {
-	static Expression const zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 	clearValues(_variables);
 
 	MovableChecker movableChecker{m_dialect};
@@ -150,7 +263,7 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		movableChecker.visit(*_value);
 	else
 		for (auto const& var: _variables)
-			m_value[var] = &zero;
+			m_value[var] = &m_zero;
 
 	if (_value && _variables.size() == 1)
 	{
@@ -196,6 +309,15 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// This cannot be easily tested since the substitutions will be done
 	// one by one on the fly, and the last line will just be add(1, 1)
 
+	// Clear the knowledge about storage and memory that involves the variables.
+	// Variables that only reference them keep their value.
+	for (auto* knowledge: {&m_storage, &m_memory})
+		for (auto it = knowledge->begin(); it != knowledge->end();)
+			if (_variables.count(it->first) || _variables.count(it->second))
+				it = knowledge->erase(it);
+			else
+				++it;
+
 	// Clear variables that reference variables to be cleared.
 	for (auto const& name: _variables)
 		for (auto const& ref: m_referencedBy[name])
@@ -223,3 +345,51 @@ bool DataFlowAnalyzer::inScope(YulString _variableName) const
 	}
 	return false;
 }
+
+void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expression)
+{
+	SideEffectsCollector sideEffects(m_dialect, _expression);
+	if (sideEffects.invalidatesStorage())
+		m_storage.clear();
+	if (sideEffects.invalidatesMemory())
+		m_memory.clear();
+}
+
+void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
+{
+	SideEffectsCollector sideEffects(m_dialect, _block);
+	if (sideEffects.invalidatesStorage())
+		m_storage.clear();
+	if (sideEffects.invalidatesMemory())
+		m_memory.clear();
+}
+
+void DataFlowAnalyzer::joinKnowledge(
+	map<YulString, YulString> const& _olderStorage,
+	map<YulString, YulString> const& _olderMemory
+)
+{
+	intersect(m_storage, _olderStorage);
+	intersect(m_memory, _olderMemory);
+}
+
+boost::optional<YulString> DataFlowAnalyzer::storeOperand(Expression const& _expression) const
+{
+	Expression const* expression = &_expression;
+	if (expression->type() == typeid(Identifier))
+	{
+		YulString name = boost::get<Identifier>(*expression).name;
+		auto value = m_value.find(name);
+		if (value == m_value.end() || value->second->type() != typeid(Literal))
+			return name;
+		expression = value->second;
+	}
+	if (expression->type() == typeid(Literal))
+		return YulString{valueOfLiteral(boost::get<Literal>(*expression)).str()};
+	return boost::none;
+}
+
+bool DataFlowAnalyzer::isLiteralOperand(YulString _operand)
+{
+	return isLiteral(_operand);
+}
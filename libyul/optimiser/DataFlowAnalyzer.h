@@ -23,8 +23,13 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
 #include <libyul/YulString.h>
 
+#include <libdevcore/Common.h>
+
+#include <boost/optional.hpp>
+
 #include <map>
 #include <set>
 
@@ -39,6 +44,12 @@ struct Dialect;
  *
  * A special zero constant expression is used for the default value of variables.
  *
+ * The class also tracks the contents of storage and memory that were written by
+ * ``sstore(k, v)`` and ``mstore(k, v)`` where both arguments are variables or number literals.
+ * The knowledge is invalidated by any statement that may write to storage or memory
+ * (writes to different literal locations are kept), by assignments to the variables
+ * involved and at control-flow joins it is reduced to what is known on all paths.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class DataFlowAnalyzer: public ASTModifier
@@ -47,6 +58,7 @@ public:
 	explicit DataFlowAnalyzer(Dialect const& _dialect): m_dialect(_dialect) {}
 
 	using ASTModifier::operator();
+	void operator()(ExpressionStatement& _statement) override;
 	void operator()(Assignment& _assignment) override;
 	void operator()(VariableDeclaration& _varDecl) override;
 	void operator()(If& _if) override;
@@ -72,13 +84,39 @@ protected:
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
 
+	/// Clears the knowledge about storage and memory if the code may modify them.
+	void clearKnowledgeIfInvalidated(Expression const& _expression);
+	void clearKnowledgeIfInvalidated(Block const& _block);
+
+	/// Removes all knowledge about storage and memory that is not also present in
+	/// @a _olderStorage and @a _olderMemory, respectively.
+	void joinKnowledge(
+		std::map<YulString, YulString> const& _olderStorage,
+		std::map<YulString, YulString> const& _olderMemory
+	);
+
+	/// @returns the operand used to track storage and memory contents for @a _expression:
+	/// the decimal value if it is a number literal or a variable with a known literal value,
+	/// the name if it is any other variable and nothing otherwise.
+	boost::optional<YulString> storeOperand(Expression const& _expression) const;
+	/// @returns true iff @a _operand was returned by storeOperand for a literal.
+	static bool isLiteralOperand(YulString _operand);
+
 	/// Current values of variables, always movable.
 	std::map<YulString, Expression const*> m_value;
+	/// Value of variables assigned without value. Not static, since YulStrings
+	/// must not outlive a reset of the YulStringRepository.
+	Expression const m_zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 	/// m_references[a].contains(b) <=> the current expression assigned to a references b
 	std::map<YulString, std::set<YulString>> m_references;
 	/// m_referencedBy[b].contains(a) <=> the current expression assigned to a references b
 	std::map<YulString, std::set<YulString>> m_referencedBy;
 
+	/// m_storage[k] == v <=> storage slot k is known to contain v (operands as returned by storeOperand)
+	std::map<YulString, YulString> m_storage;
+	/// m_memory[k] == v <=> the 32 bytes in memory starting at k are known to contain v
+	std::map<YulString, YulString> m_memory;
+
 	struct Scope
 	{
 		explicit Scope(bool _isFunction): isFunction(_isFunction) {}
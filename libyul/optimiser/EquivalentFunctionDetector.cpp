@@ -19,10 +19,8 @@
  */
 
 #include <libyul/optimiser/EquivalentFunctionDetector.h>
-#include <libyul/optimiser/SyntacticalEquality.h>
 
 #include <libyul/AsmData.h>
-#include <libyul/optimiser/Metrics.h>
 
 using namespace std;
 using namespace dev;
@@ -30,33 +28,13 @@ using namespace yul;
 
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	RoughHeuristic heuristic(_fun);
-	auto& candidates = m_candidates[heuristic];
+	CompactAST::NodeID function = m_functions.append(_fun);
+	auto& candidates = m_candidates[m_functions.hash(function)];
 	for (auto const& candidate: candidates)
-		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
+		if (m_functions.equal(function, candidate.first))
 		{
-			m_duplicates[_fun.name] = candidate;
+			m_duplicates[_fun.name] = candidate.second;
 			return;
 		}
-	candidates.push_back(&_fun);
-}
-
-bool EquivalentFunctionDetector::RoughHeuristic::operator<(EquivalentFunctionDetector::RoughHeuristic const& _rhs) const
-{
-	if (
-		std::make_tuple(m_fun.parameters.size(), m_fun.returnVariables.size()) ==
-		std::make_tuple(_rhs.m_fun.parameters.size(), _rhs.m_fun.returnVariables.size())
-	)
-		return codeSize() < _rhs.codeSize();
-	else
-		return
-			std::make_tuple(m_fun.parameters.size(), m_fun.returnVariables.size()) <
-			std::make_tuple(_rhs.m_fun.parameters.size(), _rhs.m_fun.returnVariables.size());
-}
-
-size_t EquivalentFunctionDetector::RoughHeuristic::codeSize() const
-{
-	if (!m_codeSize)
-		m_codeSize = CodeSize::codeSize(m_fun.body);
-	return *m_codeSize;
+	candidates.emplace_back(function, &_fun);
 }
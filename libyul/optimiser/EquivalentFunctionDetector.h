@@ -20,6 +20,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/CompactAST.h>
 #include <libyul/AsmDataForward.h>
 
 namespace yul
@@ -45,25 +46,11 @@ public:
 
 private:
 	EquivalentFunctionDetector() = default;
-	/**
-	 * Fast heuristic to detect distinct, resp. potentially equal functions.
-	 *
-	 * Defines a partial order on function definitions. If two functions
-	 * are comparable (one is "less" than the other), they are distinct.
-	 * If not (neither is "less" than the other), they are *potentially* equal.
-	 */
-	class RoughHeuristic
-	{
-	public:
-		RoughHeuristic(FunctionDefinition const& _fun): m_fun(_fun) {}
-		bool operator<(RoughHeuristic const& _rhs) const;
-	private:
-		std::size_t codeSize() const;
-		FunctionDefinition const& m_fun;
-		mutable boost::optional<std::size_t> m_codeSize;
-		// In case the heuristic doesn't turn out to be good enough, we might want to define a hash function for code blocks.
-	};
-	std::map<RoughHeuristic, std::vector<FunctionDefinition const*>> m_candidates;
+
+	/// Compact copies of the functions seen so far, which are compared much faster than the AST.
+	CompactAST m_functions;
+	/// Potentially equal functions grouped by their hash, with the IDs of their compact copies.
+	std::map<std::size_t, std::vector<std::pair<CompactAST::NodeID, FunctionDefinition const*>>> m_candidates;
 	std::map<YulString, FunctionDefinition const*> m_duplicates;
 };
 
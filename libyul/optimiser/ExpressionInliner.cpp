@@ -22,7 +22,9 @@
 
 #include <libyul/optimiser/InlinableExpressionFunctionFinder.h>
 #include <libyul/optimiser/Substitution.h>
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AsmData.h>
 
 #include <boost/algorithm/cxx11/all_of.hpp>
@@ -36,6 +38,8 @@ void ExpressionInliner::run()
 	InlinableExpressionFunctionFinder funFinder;
 	funFinder(m_block);
 	m_inlinableFunctions = funFinder.inlinableFunctions();
+	if (m_meter)
+		m_references = ReferencesCounter::countReferences(m_block);
 
 	(*this)(m_block);
 }
@@ -60,13 +64,28 @@ void ExpressionInliner::visit(Expression& _expression)
 		if (m_inlinableFunctions.count(funCall.functionName.name) && movable)
 		{
 			FunctionDefinition const& fun = *m_inlinableFunctions.at(funCall.functionName.name);
+			Expression const& body = *boost::get<Assignment>(fun.body.statements.front()).value;
 			map<YulString, Expression const*> substitutions;
 			for (size_t i = 0; i < fun.parameters.size(); ++i)
 				substitutions[fun.parameters[i].name] = &funCall.arguments[i];
-			_expression = Substitution(substitutions).translate(*boost::get<Assignment>(fun.body.statements.front()).value);
-
-			// TODO Add metric! This metric should perform well on a pair of functions who
-			// call each other recursively.
+			Expression inlined = Substitution(substitutions).translate(body);
+			if (!m_meter)
+				_expression = std::move(inlined);
+			else
+			{
+				// The function can be removed once its last call is inlined, which saves its body.
+				bigint callCosts = m_meter->costs(_expression);
+				if (m_references[funCall.functionName.name] == 1)
+					callCosts += m_meter->costs(body);
+				if (m_meter->costs(inlined) <= callCosts)
+				{
+					for (auto const& reference: ReferencesCounter::countReferences(_expression))
+						m_references[reference.first] -= reference.second;
+					for (auto const& reference: ReferencesCounter::countReferences(inlined))
+						m_references[reference.first] += reference.second;
+					_expression = std::move(inlined);
+				}
+			}
 		}
 	}
 }
@@ -30,6 +30,7 @@
 namespace yul
 {
 struct Dialect;
+class GasMeter;
 
 /**
  * Optimiser component that modifies an AST in place, inlining functions that can be
@@ -40,13 +41,18 @@ struct Dialect;
  *
  * Furthermore, the arguments of the function call cannot have any side-effects.
  *
+ * If a gas meter is provided, the call is only inlined if this is not more expensive
+ * than evaluating the call, which can happen if arguments are referenced multiple times.
+ * For the last remaining call of a function, the costs of the body are added to the
+ * costs of the call, because the function can be removed once it is inlined.
+ *
  * This component can only be used on sources with unique names.
  */
 class ExpressionInliner: public ASTModifier
 {
 public:
-	ExpressionInliner(Dialect const& _dialect, Block& _block):
-		m_block(_block), m_dialect(_dialect)
+	ExpressionInliner(Dialect const& _dialect, Block& _block, GasMeter const* _meter = nullptr):
+		m_block(_block), m_dialect(_dialect), m_meter(_meter)
 	{}
 
 	void run();
@@ -59,11 +65,14 @@ public:
 private:
 	std::map<YulString, FunctionDefinition const*> m_inlinableFunctions;
 	std::map<YulString, YulString> m_varReplacements;
+	/// Number of references to each name, only maintained if a gas meter is provided.
+	std::map<YulString, size_t> m_references;
 	/// Set of functions we are currently visiting inside.
 	std::set<YulString> m_currentFunctions;
 
 	Block& m_block;
 	Dialect const& m_dialect;
+	GasMeter const* m_meter = nullptr;
 };
 
 
@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
+ * currently stored in storage resp. memory, if known, and hashes of known memory contents by their value.
+ */
+
+#include <libyul/optimiser/LoadResolver.h>
+
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Keccak256.h>
+#include <libdevcore/Profiler.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+size_t constexpr LoadResolver::maxKeccakLength;
+
+void LoadResolver::run(Dialect const& _dialect, Block& _ast)
+{
+	bool containsMSize = MSizeFinder::containsMSize(_ast);
+	LoadResolver{_dialect, !containsMSize}(_ast);
+}
+
+void LoadResolver::visit(Expression& _e)
+{
+	DataFlowAnalyzer::visit(_e);
+
+	if (_e.type() != typeid(FunctionalInstruction))
+		return;
+	auto const& instruction = boost::get<FunctionalInstruction>(_e);
+
+	if (instruction.instruction == eth::Instruction::KECCAK256)
+	{
+		if (m_optimizeMLoad)
+			tryEvaluateKeccak(_e);
+		return;
+	}
+
+	map<YulString, YulString> const* knowledge = nullptr;
+	if (instruction.instruction == eth::Instruction::SLOAD)
+		knowledge = &m_storage;
+	else if (instruction.instruction == eth::Instruction::MLOAD && m_optimizeMLoad)
+		knowledge = &m_memory;
+	else
+		return;
+
+	boost::optional<YulString> key = storeOperand(instruction.arguments.at(0));
+	if (!key || !knowledge->count(*key))
+		return;
+	YulString value = knowledge->at(*key);
+	if (isLiteralOperand(value))
+		_e = Literal{instruction.location, LiteralKind::Number, value, {}};
+	else if (inScope(value))
+		_e = Identifier{instruction.location, value};
+	else
+		return;
+	Profiler::instance().count("Yul loads resolved");
+}
+
+void LoadResolver::tryEvaluateKeccak(Expression& _e) const
+{
+	auto const& instruction = boost::get<FunctionalInstruction>(_e);
+	boost::optional<YulString> offset = storeOperand(instruction.arguments.at(0));
+	boost::optional<YulString> length = storeOperand(instruction.arguments.at(1));
+	if (!offset || !length || !isLiteralOperand(*offset) || !isLiteralOperand(*length))
+		return;
+	u256 start(offset->str());
+	u256 size(length->str());
+	if (size > maxKeccakLength || start + size < start)
+		return;
+
+	bytes data;
+	for (u256 word = 0; word < size; word += 32)
+	{
+		auto value = m_memory.find(YulString{(start + word).str()});
+		if (value == m_memory.end() || !isLiteralOperand(value->second))
+			return;
+		bytes wordData = toBigEndian(u256(value->second.str()));
+		data.insert(data.end(), wordData.begin(), wordData.begin() + size_t(min<u256>(32, size - word)));
+	}
+	_e = Literal{
+		instruction.location,
+		LiteralKind::Number,
+		YulString{formatNumber(u256(h256::Arith(keccak256(data))))},
+		{}
+	};
+	Profiler::instance().count("Yul hashes resolved");
+}
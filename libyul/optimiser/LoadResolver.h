@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
+ * currently stored in storage resp. memory, if known, and hashes of known memory contents by their value.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+
+namespace yul
+{
+
+struct Dialect;
+
+/**
+ * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
+ * currently stored in storage resp. memory, if known.
+ *
+ * Expressions of the form ``keccak256(p, n)`` with literal ``p`` and ``n`` are replaced
+ * by the hash if ``n`` is at most ``maxKeccakLength`` and all words in the range are
+ * known to be literals, e.g. after ``mstore(0, k) mstore(0x20, slot)``.
+ *
+ * Works best if the code is in SSA form.
+ * Memory loads and hashes are only replaced if the code does not use ``msize``.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class LoadResolver: public DataFlowAnalyzer
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+private:
+	LoadResolver(Dialect const& _dialect, bool _optimizeMLoad):
+		DataFlowAnalyzer(_dialect),
+		m_optimizeMLoad(_optimizeMLoad)
+	{}
+
+protected:
+	using ASTModifier::visit;
+	void visit(Expression& _e) override;
+
+	/// Replaces @a _e (a call to ``keccak256``) by its value if the hashed memory is known.
+	void tryEvaluateKeccak(Expression& _e) const;
+
+	/// Upper bound for the number of bytes that are hashed at compile time.
+	static size_t constexpr maxKeccakLength = 128;
+
+	bool m_optimizeMLoad = false;
+};
+
+}
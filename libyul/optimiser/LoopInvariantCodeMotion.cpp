@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that moves loop-invariant variable declarations in front of for loops.
+ */
+
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Profiler.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void LoopInvariantCodeMotion::run(Dialect const& _dialect, Block& _ast)
+{
+	LoopInvariantCodeMotion{_dialect}(_ast);
+}
+
+void LoopInvariantCodeMotion::operator()(Block& _block)
+{
+	iterateReplacing(
+		_block.statements,
+		[&](Statement& _statement) -> boost::optional<vector<Statement>>
+		{
+			// Nested loops are processed first.
+			visit(_statement);
+			if (_statement.type() == typeid(ForLoop))
+				return rewriteLoop(boost::get<ForLoop>(_statement));
+			return {};
+		}
+	);
+}
+
+boost::optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
+{
+	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
+
+	Assignments assignments;
+	assignments(_for.body);
+	assignments(_for.post);
+	// Variables that are declared or assigned anywhere in the loop are not invariant.
+	// Variables of moved declarations are removed from this set.
+	set<YulString> varsDefinedInScope = NameCollector(_for.body).names();
+	varsDefinedInScope += NameCollector(_for.post).names();
+	varsDefinedInScope += assignments.names();
+
+	vector<Statement> replacement;
+	vector<Statement> body;
+	for (Statement& statement: _for.body.statements)
+		if (
+			statement.type() == typeid(VariableDeclaration) &&
+			canBePromoted(boost::get<VariableDeclaration>(statement), varsDefinedInScope, assignments.names())
+		)
+		{
+			varsDefinedInScope.erase(boost::get<VariableDeclaration>(statement).variables.front().name);
+			replacement.emplace_back(std::move(statement));
+		}
+		else
+			body.emplace_back(std::move(statement));
+
+	_for.body.statements = std::move(body);
+	if (replacement.empty())
+		return {};
+
+	Profiler::instance().count("Yul loop-invariant declarations moved", replacement.size());
+	replacement.emplace_back(std::move(_for));
+	return replacement;
+}
+
+bool LoopInvariantCodeMotion::canBePromoted(
+	VariableDeclaration const& _varDecl,
+	set<YulString> const& _varsDefinedInScope,
+	set<YulString> const& _assignedVariables
+) const
+{
+	// A declaration can be promoted iff
+	// 1. it declares a single variable that is not re-assigned in the loop,
+	// 2. its value is movable and
+	// 3. all variables its value references are defined outside of the loop
+	//    or by declarations that are promoted as well.
+	if (_varDecl.variables.size() != 1 || !_varDecl.value)
+		return false;
+	if (_assignedVariables.count(_varDecl.variables.front().name))
+		return false;
+	MovableChecker checker(m_dialect, *_varDecl.value);
+	if (!checker.movable())
+		return false;
+	for (YulString ref: checker.referencedVariables())
+		if (_varsDefinedInScope.count(ref))
+			return false;
+	return true;
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that moves loop-invariant variable declarations in front of for loops.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/YulString.h>
+
+#include <boost/optional.hpp>
+
+#include <set>
+#include <vector>
+
+namespace yul
+{
+
+struct Dialect;
+
+/**
+ * Optimisation stage that moves variable declarations out of the body of a for loop
+ * and in front of the loop, if their value is movable and only depends on variables
+ * that are not modified in the loop.
+ *
+ * Example:
+ *
+ *   for { } lt(i, n) { i := add(i, 1) } {
+ *     let len := calldataload(4)
+ *     let p := add(i, len)
+ *     ...
+ *   }
+ *
+ * is transformed to
+ *
+ *   let len := calldataload(4)
+ *   for { } lt(i, n) { i := add(i, 1) } {
+ *     let p := add(i, len)
+ *     ...
+ *   }
+ *
+ * Only single-variable declarations at the top level of the loop body are moved
+ * and only if the variable itself is not re-assigned in the loop. Since the
+ * values are movable, evaluating them even if the loop body is not executed
+ * does not change the semantics. Nested loops are processed first, so that
+ * declarations can move out of several loops.
+ *
+ * Works best in SSA form after the Expression Splitter was run.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class LoopInvariantCodeMotion: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	explicit LoopInvariantCodeMotion(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	/// @returns the declarations moved out of @a _for, followed by the loop itself,
+	/// or nothing if no declaration can be moved.
+	boost::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
+	bool canBePromoted(
+		VariableDeclaration const& _varDecl,
+		std::set<YulString> const& _varsDefinedInScope,
+		std::set<YulString> const& _assignedVariables
+	) const;
+
+	Dialect const& m_dialect;
+};
+
+}
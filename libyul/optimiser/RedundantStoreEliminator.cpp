@@ -0,0 +1,482 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that removes ``sstore`` and ``mstore`` statements whose stored
+ * value is overwritten or discarded before it is read.
+ */
+
+#include <libyul/optimiser/RedundantStoreEliminator.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AsmData.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Profiler.h>
+
+#include <boost/range/algorithm_ext/erase.hpp>
+
+#include <cctype>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+namespace
+{
+
+/**
+ * Collects the variables that are declared with a literal value and never re-assigned.
+ */
+class ConstantCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		if (
+			_varDecl.variables.size() == 1 &&
+			_varDecl.value &&
+			_varDecl.value->type() == typeid(Literal)
+		)
+			m_constants[_varDecl.variables.front().name] = valueOfLiteral(boost::get<Literal>(*_varDecl.value));
+	}
+
+	static map<YulString, u256> constants(Block const& _ast)
+	{
+		ConstantCollector collector;
+		collector(_ast);
+		Assignments assignments;
+		assignments(_ast);
+		for (auto const& name: assignments.names())
+			collector.m_constants.erase(name);
+		return collector.m_constants;
+	}
+
+private:
+	map<YulString, u256> m_constants;
+};
+
+/**
+ * Removes the given expression statements.
+ */
+class StoreRemover: public ASTModifier
+{
+public:
+	explicit StoreRemover(set<ExpressionStatement const*> const& _toRemove):
+		m_toRemove(_toRemove)
+	{}
+	void operator()(Block& _block) override
+	{
+		boost::range::remove_erase_if(_block.statements, [=](Statement const& _statement) -> bool {
+			return
+				_statement.type() == typeid(ExpressionStatement) &&
+				m_toRemove.count(&boost::get<ExpressionStatement>(_statement));
+		});
+
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	set<ExpressionStatement const*> const& m_toRemove;
+};
+
+bool isLiteralKey(YulString _key)
+{
+	return !_key.empty() && isdigit(_key.str().front());
+}
+
+}
+
+void RedundantStoreEliminator::run(Dialect const& _dialect, Block& _ast)
+{
+	RedundantStoreEliminator rse{_dialect, _ast};
+	rse(_ast);
+	rse.finalize(rse.m_stores, State::Used, State::Used);
+
+	set<ExpressionStatement const*> toRemove;
+	for (auto const& store: rse.m_finalStates)
+	{
+		if (store.second != State::Unused)
+			continue;
+		auto const& instruction = boost::get<FunctionalInstruction>(store.first->expression);
+		if (
+			MovableChecker{_dialect, instruction.arguments.at(0)}.movable() &&
+			MovableChecker{_dialect, instruction.arguments.at(1)}.movable()
+		)
+			toRemove.insert(store.first);
+	}
+	Profiler::instance().count("Yul stores removed", toRemove.size());
+
+	StoreRemover{toRemove}(_ast);
+}
+
+RedundantStoreEliminator::RedundantStoreEliminator(Dialect const& _dialect, Block const& _ast):
+	m_dialect(_dialect),
+	m_trackMemory(!MSizeFinder::containsMSize(_ast)),
+	m_constants(ConstantCollector::constants(_ast))
+{
+}
+
+void RedundantStoreEliminator::operator()(FunctionalInstruction const& _instruction)
+{
+	ASTWalker::operator()(_instruction);
+
+	vector<Expression> const& arguments = _instruction.arguments;
+	switch (_instruction.instruction)
+	{
+	case eth::Instruction::SLOAD:
+		read(true, locationKey(arguments.at(0)), 1);
+		break;
+	case eth::Instruction::MLOAD:
+		read(false, locationKey(arguments.at(0)), 32);
+		break;
+	case eth::Instruction::KECCAK256:
+		readMemoryArea(arguments.at(0), arguments.at(1));
+		break;
+	case eth::Instruction::CALL:
+	case eth::Instruction::CALLCODE:
+	case eth::Instruction::DELEGATECALL:
+	case eth::Instruction::STATICCALL:
+	case eth::Instruction::CREATE:
+	case eth::Instruction::CREATE2:
+		// The callee can re-enter and read the storage.
+		readAll(true, true);
+		break;
+	case eth::Instruction::RETURN:
+		readMemoryArea(arguments.at(0), arguments.at(1));
+		terminate(State::Used);
+		break;
+	case eth::Instruction::REVERT:
+		readMemoryArea(arguments.at(0), arguments.at(1));
+		terminate(State::Unused);
+		break;
+	case eth::Instruction::STOP:
+	case eth::Instruction::SELFDESTRUCT:
+		terminate(State::Used);
+		break;
+	case eth::Instruction::INVALID:
+		terminate(State::Unused);
+		break;
+	default:
+		if (eth::isLogInstruction(_instruction.instruction))
+			readMemoryArea(arguments.at(0), arguments.at(1));
+		break;
+	}
+}
+
+void RedundantStoreEliminator::operator()(FunctionCall const& _functionCall)
+{
+	ASTWalker::operator()(_functionCall);
+
+	BuiltinFunction const* f = m_dialect.builtin(_functionCall.functionName.name);
+	if (!f || !f->movable)
+		readAll(true, true);
+}
+
+void RedundantStoreEliminator::operator()(ExpressionStatement const& _statement)
+{
+	if (_statement.expression.type() == typeid(FunctionalInstruction))
+	{
+		auto const& instruction = boost::get<FunctionalInstruction>(_statement.expression);
+		bool const isStorage = instruction.instruction == eth::Instruction::SSTORE;
+		if (isStorage || instruction.instruction == eth::Instruction::MSTORE)
+		{
+			ASTWalker::operator()(instruction);
+			store(_statement, isStorage, instruction.arguments.at(0));
+			return;
+		}
+	}
+	ASTWalker::operator()(_statement);
+}
+
+void RedundantStoreEliminator::operator()(VariableDeclaration const& _variableDeclaration)
+{
+	ASTWalker::operator()(_variableDeclaration);
+
+	// Inside for loops, the same variable is declared again in every iteration.
+	set<YulString> names;
+	for (auto const& var: _variableDeclaration.variables)
+		names.emplace(var.name);
+	for (auto& store: m_stores)
+		if (names.count(m_locations.at(store.first).key))
+			store.second.locationValid = false;
+}
+
+void RedundantStoreEliminator::operator()(Assignment const& _assignment)
+{
+	visit(*_assignment.value);
+
+	set<YulString> names;
+	for (auto const& var: _assignment.variableNames)
+		names.emplace(var.name);
+	for (auto& store: m_stores)
+		if (names.count(m_locations.at(store.first).key))
+			store.second.locationValid = false;
+}
+
+void RedundantStoreEliminator::operator()(If const& _if)
+{
+	visit(*_if.condition);
+
+	TrackedStores skipBranch{m_stores};
+	(*this)(_if.body);
+
+	merge(m_stores, move(skipBranch));
+}
+
+void RedundantStoreEliminator::operator()(Switch const& _switch)
+{
+	visit(*_switch.expression);
+
+	TrackedStores const preState{m_stores};
+
+	bool hasDefault = false;
+	vector<TrackedStores> branches;
+	for (auto const& c: _switch.cases)
+	{
+		if (!c.value)
+			hasDefault = true;
+		(*this)(c.body);
+		branches.emplace_back(move(m_stores));
+		m_stores = preState;
+	}
+
+	if (hasDefault)
+	{
+		m_stores = move(branches.back());
+		branches.pop_back();
+	}
+	for (auto& branch: branches)
+		merge(m_stores, move(branch));
+}
+
+void RedundantStoreEliminator::operator()(FunctionDefinition const& _functionDefinition)
+{
+	TrackedStores outerStores;
+	ForLoopInfo forLoopInfo;
+	swap(m_stores, outerStores);
+	swap(m_forLoopInfo, forLoopInfo);
+
+	(*this)(_functionDefinition.body);
+	// The caller might read everything.
+	finalize(m_stores, State::Used, State::Used);
+
+	swap(m_stores, outerStores);
+	swap(m_forLoopInfo, forLoopInfo);
+}
+
+void RedundantStoreEliminator::operator()(ForLoop const& _forLoop)
+{
+	ForLoopInfo outerForLoopInfo;
+	swap(outerForLoopInfo, m_forLoopInfo);
+	++m_forLoopNestingDepth;
+
+	assertThrow(_forLoop.pre.statements.empty(), OptimizerException, "");
+
+	// As in the RedundantAssignEliminator, we run the loop twice to account for the back edge.
+
+	visit(*_forLoop.condition);
+
+	TrackedStores zeroRuns{m_stores};
+
+	(*this)(_forLoop.body);
+	merge(m_stores, move(m_forLoopInfo.pendingContinueStmts));
+	m_forLoopInfo.pendingContinueStmts = {};
+	(*this)(_forLoop.post);
+
+	visit(*_forLoop.condition);
+
+	if (m_forLoopNestingDepth < 6)
+	{
+		TrackedStores oneRun{m_stores};
+
+		(*this)(_forLoop.body);
+
+		merge(m_stores, move(m_forLoopInfo.pendingContinueStmts));
+		m_forLoopInfo.pendingContinueStmts.clear();
+		(*this)(_forLoop.post);
+
+		visit(*_forLoop.condition);
+		merge(m_stores, move(oneRun));
+	}
+	else
+	{
+		// Shortcut to avoid horrible runtime:
+		// Change all stores that were newly introduced in the for loop to "used".
+		for (auto& store: m_stores)
+			if (!zeroRuns.count(store.first))
+				store.second.state = State::Used;
+	}
+
+	merge(m_stores, move(zeroRuns));
+	merge(m_stores, move(m_forLoopInfo.pendingBreakStmts));
+	m_forLoopInfo.pendingBreakStmts.clear();
+
+	swap(m_forLoopInfo, outerForLoopInfo);
+	--m_forLoopNestingDepth;
+}
+
+void RedundantStoreEliminator::operator()(Break const&)
+{
+	m_forLoopInfo.pendingBreakStmts.emplace_back(move(m_stores));
+	m_stores.clear();
+}
+
+void RedundantStoreEliminator::operator()(Continue const&)
+{
+	m_forLoopInfo.pendingContinueStmts.emplace_back(move(m_stores));
+	m_stores.clear();
+}
+
+void RedundantStoreEliminator::merge(TrackedStores& _target, TrackedStores&& _other)
+{
+	joinMap(_target, move(_other), [](TrackedStore& _storeHere, TrackedStore&& _storeThere)
+	{
+		State::join(_storeHere.state, _storeThere.state);
+		_storeHere.locationValid = _storeHere.locationValid && _storeThere.locationValid;
+	});
+}
+
+void RedundantStoreEliminator::merge(TrackedStores& _target, vector<TrackedStores>&& _source)
+{
+	for (TrackedStores& ts: _source)
+		merge(_target, move(ts));
+	_source.clear();
+}
+
+YulString RedundantStoreEliminator::locationKey(Expression const& _expression) const
+{
+	if (boost::optional<u256> value = constantValue(_expression))
+		return YulString{value->str()};
+	if (_expression.type() == typeid(Identifier))
+		return boost::get<Identifier>(_expression).name;
+	return {};
+}
+
+boost::optional<u256> RedundantStoreEliminator::constantValue(Expression const& _expression) const
+{
+	if (_expression.type() == typeid(Literal))
+		return valueOfLiteral(boost::get<Literal>(_expression));
+	if (_expression.type() == typeid(Identifier))
+	{
+		auto it = m_constants.find(boost::get<Identifier>(_expression).name);
+		if (it != m_constants.end())
+			return it->second;
+	}
+	return boost::none;
+}
+
+void RedundantStoreEliminator::store(ExpressionStatement const& _statement, bool _storage, Expression const& _location)
+{
+	if (!_storage && !m_trackMemory)
+		return;
+
+	YulString key = locationKey(_location);
+	if (!key.empty())
+		for (auto& store: m_stores)
+		{
+			Location const& location = m_locations.at(store.first);
+			if (
+				store.second.state == State::Undecided &&
+				store.second.locationValid &&
+				location.storage == _storage &&
+				location.key == key
+			)
+				store.second.state = State::Unused;
+		}
+
+	m_locations[&_statement] = Location{_storage, key};
+	// If the store was already visited on this path (in a previous iteration
+	// of a loop), the state applies to both executions.
+	TrackedStore& tracked = m_stores[&_statement];
+	if (tracked.state == State::Unused)
+		tracked.state = State::Undecided;
+	tracked.locationValid = tracked.locationValid && !key.empty();
+}
+
+void RedundantStoreEliminator::read(bool _storage, YulString _key, bigint const& _size)
+{
+	bool const literalKey = isLiteralKey(_key);
+	for (auto& store: m_stores)
+	{
+		if (store.second.state != State::Undecided)
+			continue;
+		Location const& location = m_locations.at(store.first);
+		if (location.storage != _storage)
+			continue;
+		if (literalKey && store.second.locationValid && isLiteralKey(location.key))
+		{
+			bigint readStart(u256(_key.str()));
+			bigint writeStart(u256(location.key.str()));
+			bigint writeSize = _storage ? 1 : 32;
+			if (writeStart + writeSize <= readStart || readStart + _size <= writeStart)
+				continue;
+		}
+		store.second.state = State::Used;
+	}
+}
+
+void RedundantStoreEliminator::readMemoryArea(Expression const& _offset, Expression const& _size)
+{
+	boost::optional<u256> offset = constantValue(_offset);
+	boost::optional<u256> size = constantValue(_size);
+	if (size && *size == 0)
+		return;
+	if (offset && size)
+		read(false, YulString{offset->str()}, bigint(*size));
+	else
+		readAll(false, true);
+}
+
+void RedundantStoreEliminator::readAll(bool _storage, bool _memory)
+{
+	for (auto& store: m_stores)
+		if (store.second.state == State::Undecided)
+		{
+			bool const storage = m_locations.at(store.first).storage;
+			if (storage ? _storage : _memory)
+				store.second.state = State::Used;
+		}
+}
+
+void RedundantStoreEliminator::terminate(State _storageState)
+{
+	// Memory is discarded at the end of the execution.
+	finalize(m_stores, _storageState, State::Unused);
+}
+
+void RedundantStoreEliminator::finalize(TrackedStores& _stores, State _storageState, State _memoryState)
+{
+	for (auto const& store: _stores)
+	{
+		State state = store.second.state;
+		if (state == State::Undecided)
+			state = m_locations.at(store.first).storage ? _storageState : _memoryState;
+		auto it = m_finalStates.find(store.first);
+		if (it == m_finalStates.end())
+			m_finalStates[store.first] = state;
+		else
+			State::join(it->second, state);
+	}
+	_stores.clear();
+}
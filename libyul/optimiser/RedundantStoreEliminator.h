@@ -0,0 +1,176 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that removes ``sstore`` and ``mstore`` statements whose stored
+ * value is overwritten or discarded before it is read.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/YulString.h>
+
+#include <libdevcore/Common.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <vector>
+
+namespace yul
+{
+struct Dialect;
+
+/**
+ * Optimiser component that removes ``sstore(k, v)`` and ``mstore(k, v)`` statements
+ * if the written value is not read on any control-flow path, because the location
+ * is overwritten first or because execution ends in a way that discards it.
+ *
+ * Example:
+ *
+ * {
+ *   sstore(0, 1)
+ *   mstore(0x80, 2)
+ *   if calldataload(0) { sstore(0, 3) }
+ *   sstore(0, 4)
+ *   return(0, 0x20)
+ * }
+ *
+ * Here, ``sstore(0, 1)`` and ``sstore(0, 3)`` are removed because slot zero is
+ * overwritten on all paths before it can be read. ``mstore(0x80, 2)`` is removed
+ * because the memory outside of the returned area is discarded by ``return``.
+ *
+ * The algorithm follows the one of the RedundantAssignEliminator: Every tracked store
+ * is in one of the states "unused", "undecided" or "used". A store is added in the
+ * "undecided" state and all "undecided" stores to the same location are changed to "unused".
+ * Any instruction that might read from a location (including calls to user-defined functions,
+ * external calls and contract creation) changes the state of "undecided" stores
+ * to that location to "used". Control flow is joined as in the RedundantAssignEliminator.
+ *
+ * Two locations are the same if they are given by the same literal value or the same
+ * variable that was not re-assigned in between. Locations given by different variables
+ * are assumed to potentially overlap. Variables that are initialized with a literal
+ * and never re-assigned are treated as the literal.
+ *
+ * At ``return`` and ``stop``, "undecided" stores to storage change to "used" and
+ * "undecided" stores to memory change to "unused", after the returned memory area was read.
+ * At ``revert`` and ``invalid``, all "undecided" stores change to "unused".
+ * At the end of a function or of the code, all "undecided" stores change to "used",
+ * since the code might be part of a larger program.
+ *
+ * Stores to memory are not removed at all if the code uses ``msize``.
+ * Stores are only removed if their arguments are movable.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ * Works best in SSA form after the Common Subexpression Eliminator was run.
+ */
+class RedundantStoreEliminator: public ASTWalker
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTWalker::operator();
+	void operator()(FunctionalInstruction const& _instruction) override;
+	void operator()(FunctionCall const& _functionCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(VariableDeclaration const& _variableDeclaration) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+
+private:
+	RedundantStoreEliminator(Dialect const& _dialect, Block const& _ast);
+
+	class State
+	{
+	public:
+		enum Value { Unused, Undecided, Used };
+		State(Value _value = Undecided): m_value(_value) {}
+		inline bool operator==(State _other) const { return m_value == _other.m_value; }
+		inline bool operator!=(State _other) const { return !operator==(_other); }
+		static inline void join(State& _a, State const& _b)
+		{
+			// Using "max" works here because of the order of the values in the enum.
+			_a.m_value =  Value(std::max(int(_a.m_value), int(_b.m_value)));
+		}
+	private:
+		Value m_value = Undecided;
+	};
+
+	/// State of a store on the current control-flow path.
+	struct TrackedStore
+	{
+		State state;
+		/// False if a variable used as the location was re-assigned since the store.
+		bool locationValid = true;
+	};
+	using TrackedStores = std::map<ExpressionStatement const*, TrackedStore>;
+
+	struct Location
+	{
+		bool storage = false;
+		/// Variable name or decimal value of the location, empty if unknown.
+		YulString key;
+	};
+
+	/// Joins the store states of @a _source into @a _target. Will destroy @a _source.
+	static void merge(TrackedStores& _target, TrackedStores&& _source);
+	static void merge(TrackedStores& _target, std::vector<TrackedStores>&& _source);
+
+	/// @returns the decimal value of a literal or a constant variable, the name of any
+	/// other variable and an empty string otherwise.
+	YulString locationKey(Expression const& _expression) const;
+	boost::optional<dev::u256> constantValue(Expression const& _expression) const;
+
+	void store(ExpressionStatement const& _statement, bool _storage, Expression const& _location);
+	/// Marks all undecided stores to storage or memory as used that might overlap with
+	/// @a _size bytes (one slot for storage) at @a _key.
+	void read(bool _storage, YulString _key, dev::bigint const& _size);
+	/// Marks all undecided stores to memory as used that might overlap with the given area.
+	void readMemoryArea(Expression const& _offset, Expression const& _size);
+	void readAll(bool _storage, bool _memory);
+	/// Ends the current control-flow path.
+	void terminate(State _storageState);
+	/// Records the final state of all stores in @a _stores, using @a _storageState and
+	/// @a _memoryState for those that are still undecided, and clears @a _stores.
+	void finalize(TrackedStores& _stores, State _storageState, State _memoryState);
+
+	Dialect const& m_dialect;
+	bool m_trackMemory = true;
+	std::map<YulString, dev::u256> m_constants;
+	std::map<ExpressionStatement const*, Location> m_locations;
+	std::map<ExpressionStatement const*, State> m_finalStates;
+	TrackedStores m_stores;
+
+	/// Working data for traversing for-loops.
+	struct ForLoopInfo
+	{
+		/// Tracked store states for each break statement.
+		std::vector<TrackedStores> pendingBreakStmts;
+		/// Tracked store states for each continue statement.
+		std::vector<TrackedStores> pendingContinueStmts;
+	};
+	ForLoopInfo m_forLoopInfo;
+	size_t m_forLoopNestingDepth = 0;
+};
+
+}
@@ -23,6 +23,7 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
 
@@ -30,9 +31,14 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
-void Rematerialiser::run(Dialect const& _dialect, Block& _ast, set<YulString> _varsToAlwaysRematerialize)
+void Rematerialiser::run(
+	Dialect const& _dialect,
+	Block& _ast,
+	set<YulString> _varsToAlwaysRematerialize,
+	GasMeter const* _meter
+)
 {
-	Rematerialiser{_dialect, _ast, std::move(_varsToAlwaysRematerialize)}(_ast);
+	Rematerialiser{_dialect, _ast, std::move(_varsToAlwaysRematerialize), _meter}(_ast);
 }
 
 void Rematerialiser::run(
@@ -47,11 +53,13 @@ void Rematerialiser::run(
 Rematerialiser::Rematerialiser(
 	Dialect const& _dialect,
 	Block& _ast,
-	set<YulString> _varsToAlwaysRematerialize
+	set<YulString> _varsToAlwaysRematerialize,
+	GasMeter const* _meter
 ):
 	DataFlowAnalyzer(_dialect),
 	m_referenceCounts(ReferencesCounter::countReferences(_ast)),
-	m_varsToAlwaysRematerialize(std::move(_varsToAlwaysRematerialize))
+	m_varsToAlwaysRematerialize(std::move(_varsToAlwaysRematerialize)),
+	m_meter(_meter)
 {
 }
 
@@ -77,8 +85,17 @@ void Rematerialiser::visit(Expression& _e)
 			assertThrow(m_value.at(name), OptimizerException, "");
 			auto const& value = *m_value.at(name);
 			size_t refs = m_referenceCounts[name];
-			size_t cost = CodeCost::codeCost(value);
-			if (refs <= 1 || cost == 0 || (refs <= 5 && cost <= 1) || m_varsToAlwaysRematerialize.count(name))
+			bool rematerialise = refs <= 1 || m_varsToAlwaysRematerialize.count(name);
+			if (!rematerialise && m_meter)
+				rematerialise =
+					(refs - 1) * m_meter->costs(value) <=
+					refs * m_meter->instructionCosts(dev::eth::Instruction::DUP1);
+			else if (!rematerialise)
+			{
+				size_t cost = CodeCost::codeCost(value);
+				rematerialise = cost == 0 || (refs <= 5 && cost <= 1);
+			}
+			if (rematerialise)
 			{
 				assertThrow(m_referenceCounts[name] > 0, OptimizerException, "");
 				for (auto const& ref: m_references[name])
@@ -24,6 +24,7 @@
 
 namespace yul
 {
+class GasMeter;
 
 /**
  * Optimisation stage that replaces variables by their most recently assigned expressions,
@@ -33,6 +34,10 @@ namespace yul
  *  - the variable is referenced at most 5 times and the value is rather cheap
  *    ("cost" of at most 1 like a constant up to 0xff)
  *
+ * If a gas meter is provided, the last two conditions are replaced by comparing the
+ * costs of evaluating the value at every reference with the costs of evaluating it once
+ * and duplicating it for every reference.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class Rematerialiser: public DataFlowAnalyzer
@@ -41,7 +46,8 @@ public:
 	static void run(
 		Dialect const& _dialect,
 		Block& _ast,
-		std::set<YulString> _varsToAlwaysRematerialize = {}
+		std::set<YulString> _varsToAlwaysRematerialize = {},
+		GasMeter const* _meter = nullptr
 	);
 	static void run(
 		Dialect const& _dialect,
@@ -53,7 +59,8 @@ protected:
 	Rematerialiser(
 		Dialect const& _dialect,
 		Block& _ast,
-		std::set<YulString> _varsToAlwaysRematerialize = {}
+		std::set<YulString> _varsToAlwaysRematerialize = {},
+		GasMeter const* _meter = nullptr
 	);
 	Rematerialiser(
 		Dialect const& _dialect,
@@ -66,6 +73,7 @@ protected:
 
 	std::map<YulString, size_t> m_referenceCounts;
 	std::set<YulString> m_varsToAlwaysRematerialize;
+	GasMeter const* m_meter = nullptr;
 };
 
 }
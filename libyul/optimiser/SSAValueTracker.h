@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
 
 #include <map>
 #include <set>
@@ -52,6 +53,9 @@ private:
 	void setValue(YulString _name, Expression const* _value);
 
 	std::map<YulString, Expression const*> m_values;
+	/// Value of variables declared without value. Not static, since YulStrings
+	/// must not outlive a reset of the YulStringRepository.
+	Expression const m_zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 };
 
 }
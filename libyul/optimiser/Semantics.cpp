@@ -72,3 +72,63 @@ void MovableChecker::visit(Statement const&)
 {
 	assertThrow(false, OptimizerException, "Movability for statement requested.");
 }
+
+SideEffectsCollector::SideEffectsCollector(Dialect const& _dialect, Expression const& _expression):
+	SideEffectsCollector(_dialect)
+{
+	visit(_expression);
+}
+
+SideEffectsCollector::SideEffectsCollector(Dialect const& _dialect, Block const& _block):
+	SideEffectsCollector(_dialect)
+{
+	(*this)(_block);
+}
+
+void SideEffectsCollector::operator()(Instruction const& _instruction)
+{
+	if (eth::SemanticInformation::invalidatesStorage(_instruction.instruction))
+		m_invalidatesStorage = true;
+	if (eth::SemanticInformation::invalidatesMemory(_instruction.instruction))
+		m_invalidatesMemory = true;
+}
+
+void SideEffectsCollector::operator()(FunctionalInstruction const& _instr)
+{
+	ASTWalker::operator()(_instr);
+	if (eth::SemanticInformation::invalidatesStorage(_instr.instruction))
+		m_invalidatesStorage = true;
+	if (eth::SemanticInformation::invalidatesMemory(_instr.instruction))
+		m_invalidatesMemory = true;
+}
+
+void SideEffectsCollector::operator()(FunctionCall const& _functionCall)
+{
+	ASTWalker::operator()(_functionCall);
+	BuiltinFunction const* f = m_dialect.builtin(_functionCall.functionName.name);
+	if (!f || !f->movable)
+	{
+		m_invalidatesStorage = true;
+		m_invalidatesMemory = true;
+	}
+}
+
+bool MSizeFinder::containsMSize(Block const& _ast)
+{
+	MSizeFinder finder;
+	finder(_ast);
+	return finder.m_msizeFound;
+}
+
+void MSizeFinder::operator()(Instruction const& _instruction)
+{
+	if (_instruction.instruction == eth::Instruction::MSIZE)
+		m_msizeFound = true;
+}
+
+void MSizeFinder::operator()(FunctionalInstruction const& _instr)
+{
+	ASTWalker::operator()(_instr);
+	if (_instr.instruction == eth::Instruction::MSIZE)
+		m_msizeFound = true;
+}
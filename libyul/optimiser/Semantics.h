@@ -56,4 +56,45 @@ private:
 	bool m_movable = true;
 };
 
+/**
+ * Specific AST walker that determines whether a piece of code can modify storage or memory.
+ * Calls to functions other than movable builtins are assumed to modify both.
+ */
+class SideEffectsCollector: public ASTWalker
+{
+public:
+	explicit SideEffectsCollector(Dialect const& _dialect): m_dialect(_dialect) {}
+	SideEffectsCollector(Dialect const& _dialect, Expression const& _expression);
+	SideEffectsCollector(Dialect const& _dialect, Block const& _block);
+
+	using ASTWalker::operator();
+	void operator()(Instruction const& _instruction) override;
+	void operator()(FunctionalInstruction const& _functionalInstruction) override;
+	void operator()(FunctionCall const& _functionCall) override;
+
+	bool invalidatesStorage() const { return m_invalidatesStorage; }
+	bool invalidatesMemory() const { return m_invalidatesMemory; }
+
+private:
+	Dialect const& m_dialect;
+	bool m_invalidatesStorage = false;
+	bool m_invalidatesMemory = false;
+};
+
+/**
+ * Specific AST walker that determines whether the code uses the msize instruction.
+ */
+class MSizeFinder: public ASTWalker
+{
+public:
+	static bool containsMSize(Block const& _ast);
+
+	using ASTWalker::operator();
+	void operator()(Instruction const& _instruction) override;
+	void operator()(FunctionalInstruction const& _functionalInstruction) override;
+
+private:
+	bool m_msizeFound = false;
+};
+
 }
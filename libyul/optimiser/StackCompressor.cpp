@@ -27,6 +27,7 @@
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -46,13 +47,15 @@ namespace
 class RematCandidateSelector: public DataFlowAnalyzer
 {
 public:
-	explicit RematCandidateSelector(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
+	RematCandidateSelector(Dialect const& _dialect, GasMeter const* _meter):
+		DataFlowAnalyzer(_dialect), m_meter(_meter)
+	{}
 
 	/// @returns a set of pairs of rematerialisation costs and variable to rematerialise.
 	/// Note that this set is sorted by cost.
-	set<pair<size_t, YulString>> candidates()
+	set<pair<bigint, YulString>> candidates()
 	{
-		set<pair<size_t, YulString>> cand;
+		set<pair<bigint, YulString>> cand;
 		for (auto const& codeCost: m_expressionCodeCost)
 		{
 			size_t numRef = m_numReferences[codeCost.first];
@@ -69,7 +72,10 @@ public:
 		{
 			YulString varName = _varDecl.variables.front().name;
 			if (m_value.count(varName))
-				m_expressionCodeCost[varName] = CodeCost::codeCost(*m_value[varName]);
+				m_expressionCodeCost[varName] =
+					m_meter ?
+					m_meter->costs(*m_value[varName]) :
+					bigint(CodeCost::codeCost(*m_value[varName]));
 		}
 	}
 
@@ -106,15 +112,21 @@ public:
 	}
 
 	/// Candidate variables and the code cost of their value.
-	map<YulString, size_t> m_expressionCodeCost;
+	map<YulString, bigint> m_expressionCodeCost;
 	/// Number of references to each candidate variable.
 	map<YulString, size_t> m_numReferences;
+	GasMeter const* m_meter = nullptr;
 };
 
 template <typename ASTNode>
-void eliminateVariables(shared_ptr<Dialect> const& _dialect, ASTNode& _node, size_t _numVariables)
+void eliminateVariables(
+	shared_ptr<Dialect> const& _dialect,
+	ASTNode& _node,
+	size_t _numVariables,
+	GasMeter const* _meter
+)
 {
-	RematCandidateSelector selector{*_dialect};
+	RematCandidateSelector selector{*_dialect, _meter};
 	selector(_node);
 
 	// Select at most _numVariables
@@ -136,7 +148,8 @@ bool StackCompressor::run(
 	shared_ptr<Dialect> const& _dialect,
 	Block& _ast,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations
+	size_t _maxIterations,
+	GasMeter const* _meter
 )
 {
 	yulAssert(
@@ -152,7 +165,7 @@ bool StackCompressor::run(
 		if (stackSurplus.count(YulString{}))
 		{
 			yulAssert(stackSurplus.at({}) > 0, "Invalid surplus value.");
-			eliminateVariables(_dialect, boost::get<Block>(_ast.statements.at(0)), stackSurplus.at({}));
+			eliminateVariables(_dialect, boost::get<Block>(_ast.statements.at(0)), stackSurplus.at({}), _meter);
 		}
 
 		for (size_t i = 1; i < _ast.statements.size(); ++i)
@@ -162,7 +175,7 @@ bool StackCompressor::run(
 				continue;
 
 			yulAssert(stackSurplus.at(fun.name) > 0, "Invalid surplus value.");
-			eliminateVariables(_dialect, fun, stackSurplus.at(fun.name));
+			eliminateVariables(_dialect, fun, stackSurplus.at(fun.name), _meter);
 		}
 	}
 	return false;
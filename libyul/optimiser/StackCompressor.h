@@ -29,11 +29,15 @@ namespace yul
 struct Dialect;
 struct Block;
 struct FunctionDefinition;
+class GasMeter;
 
 /**
  * Optimisation stage that aggressively rematerializes certain variables in a function to free
  * space on the stack until it is compilable.
  *
+ * The variables whose rematerialisation is cheapest are chosen first, where the costs
+ * are determined by the gas meter if one is provided.
+ *
  * Prerequisite: Disambiguator, Function Grouper
  */
 class StackCompressor
@@ -45,7 +49,8 @@ public:
 		std::shared_ptr<Dialect> const& _dialect,
 		Block& _ast,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		GasMeter const* _meter = nullptr
 	);
 };
 
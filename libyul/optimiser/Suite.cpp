@@ -31,6 +31,8 @@
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedPruner.h>
@@ -41,6 +43,7 @@
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
+#include <libyul/optimiser/RedundantStoreEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/AsmAnalysis.h>
@@ -51,34 +54,57 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Profiler.h>
 
 using namespace std;
 using namespace dev;
 using namespace yul;
 
+namespace
+{
+
+/// Runs @a _step as a phase of the profiler, so that the time of every optimiser step
+/// is reported nested in the group of steps it belongs to.
+template <class Step>
+void runStep(char const* _name, Step const& _step)
+{
+	ScopedTimer timer(_name);
+	_step();
+}
+
+}
+
 void OptimiserSuite::run(
 	shared_ptr<Dialect> const& _dialect,
+	GasMeter const* _meter,
 	Block& _ast,
 	AsmAnalysisInfo const& _analysisInfo,
 	bool _optimizeStackAllocation,
 	set<YulString> const& _externallyUsedIdentifiers
 )
 {
+	ScopedTimer timer("Yul optimiser");
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 
-	Block ast = boost::get<Block>(Disambiguator(*_dialect, _analysisInfo, reservedIdentifiers)(_ast));
+	Block ast;
+	runStep("Disambiguator", [&]() {
+		ast = boost::get<Block>(Disambiguator(*_dialect, _analysisInfo, reservedIdentifiers)(_ast));
+	});
 
-	VarDeclInitializer{}(ast);
-	FunctionHoister{}(ast);
-	BlockFlattener{}(ast);
-	ForLoopInitRewriter{}(ast);
-	DeadCodeEliminator{}(ast);
-	FunctionGrouper{}(ast);
-	EquivalentFunctionCombiner::run(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-	BlockFlattener{}(ast);
-	StructuralSimplifier{*_dialect}(ast);
-	BlockFlattener{}(ast);
+	{
+		ScopedTimer phaseTimer("preparation");
+		runStep("VarDeclInitializer", [&]() { VarDeclInitializer{}(ast); });
+		runStep("FunctionHoister", [&]() { FunctionHoister{}(ast); });
+		runStep("BlockFlattener", [&]() { BlockFlattener{}(ast); });
+		runStep("ForLoopInitRewriter", [&]() { ForLoopInitRewriter{}(ast); });
+		runStep("DeadCodeEliminator", [&]() { DeadCodeEliminator{}(ast); });
+		runStep("FunctionGrouper", [&]() { FunctionGrouper{}(ast); });
+		runStep("EquivalentFunctionCombiner", [&]() { EquivalentFunctionCombiner::run(ast); });
+		runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
+		runStep("BlockFlattener", [&]() { BlockFlattener{}(ast); });
+		runStep("StructuralSimplifier", [&]() { StructuralSimplifier{*_dialect}(ast); });
+		runStep("BlockFlattener", [&]() { BlockFlattener{}(ast); });
+	}
 
 	// None of the above can make stack problems worse.
 
@@ -93,113 +119,134 @@ void OptimiserSuite::run(
 				break;
 			codeSize = newSize;
 		}
+		Profiler::instance().count("Yul optimiser rounds");
 
 		{
 			// Turn into SSA and simplify
-			ExpressionSplitter{*_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-
-			ExpressionSimplifier::run(*_dialect, ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
+			ScopedTimer phaseTimer("SSA and simplify");
+			runStep("ExpressionSplitter", [&]() { ExpressionSplitter{*_dialect, dispenser}(ast); });
+			runStep("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+
+			runStep("ExpressionSimplifier", [&]() { ExpressionSimplifier::run(*_dialect, ast); });
+			runStep("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{*_dialect}(ast); });
+			runStep("LoadResolver", [&]() { LoadResolver::run(*_dialect, ast); });
 		}
 
 		{
 			// still in SSA, perform structural simplification
-			StructuralSimplifier{*_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+			ScopedTimer phaseTimer("structural simplification");
+			runStep("StructuralSimplifier", [&]() { StructuralSimplifier{*_dialect}(ast); });
+			runStep("BlockFlattener", [&]() { BlockFlattener{}(ast); });
+			runStep("DeadCodeEliminator", [&]() { DeadCodeEliminator{}(ast); });
+			runStep("LoopInvariantCodeMotion", [&]() { LoopInvariantCodeMotion::run(*_dialect, ast); });
+			runStep("RedundantStoreEliminator", [&]() { RedundantStoreEliminator::run(*_dialect, ast); });
+			runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
 		}
 		{
 			// simplify again
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+			ScopedTimer phaseTimer("simplify again");
+			runStep("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{*_dialect}(ast); });
+			runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
 		}
 
 		{
 			// reverse SSA
-			SSAReverser::run(ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+			ScopedTimer phaseTimer("reverse SSA");
+			runStep("SSAReverser", [&]() { SSAReverser::run(ast); });
+			runStep("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{*_dialect}(ast); });
+			runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
 
-			ExpressionJoiner::run(ast);
-			ExpressionJoiner::run(ast);
+			runStep("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+			runStep("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
 		}
 
 		// should have good "compilability" property here.
 
 		{
 			// run functional expression inliner
-			ExpressionInliner(*_dialect, ast).run();
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+			ScopedTimer phaseTimer("expression inliner");
+			runStep("ExpressionInliner", [&]() { ExpressionInliner(*_dialect, ast, _meter).run(); });
+			runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
 		}
 
 		{
 			// Turn into SSA again and simplify
-			ExpressionSplitter{*_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
+			ScopedTimer phaseTimer("SSA and simplify after expression inliner");
+			runStep("ExpressionSplitter", [&]() { ExpressionSplitter{*_dialect, dispenser}(ast); });
+			runStep("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+			runStep("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{*_dialect}(ast); });
+			runStep("LoadResolver", [&]() { LoadResolver::run(*_dialect, ast); });
 		}
 
 		{
 			// run full inliner
-			FunctionGrouper{}(ast);
-			EquivalentFunctionCombiner::run(ast);
-			FullInliner{ast, dispenser}.run();
-			BlockFlattener{}(ast);
+			ScopedTimer phaseTimer("full inliner");
+			runStep("FunctionGrouper", [&]() { FunctionGrouper{}(ast); });
+			runStep("EquivalentFunctionCombiner", [&]() { EquivalentFunctionCombiner::run(ast); });
+			runStep("FullInliner", [&]() { FullInliner{ast, dispenser}.run(); });
+			runStep("BlockFlattener", [&]() { BlockFlattener{}(ast); });
 		}
 
 		{
 			// SSA plus simplify
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			ExpressionSimplifier::run(*_dialect, ast);
-			StructuralSimplifier{*_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{}(ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-			CommonSubexpressionEliminator{*_dialect}(ast);
+			ScopedTimer phaseTimer("SSA and simplify after full inliner");
+			runStep("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+			runStep("ExpressionSimplifier", [&]() { ExpressionSimplifier::run(*_dialect, ast); });
+			runStep("StructuralSimplifier", [&]() { StructuralSimplifier{*_dialect}(ast); });
+			runStep("BlockFlattener", [&]() { BlockFlattener{}(ast); });
+			runStep("DeadCodeEliminator", [&]() { DeadCodeEliminator{}(ast); });
+			runStep("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{*_dialect}(ast); });
+			runStep("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+			runStep("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(*_dialect, ast); });
+			runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
+			runStep("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{*_dialect}(ast); });
 		}
 	}
 
-	// Make source short and pretty.
-
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(*_dialect, ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-
-	SSAReverser::run(ast);
-	CommonSubexpressionEliminator{*_dialect}(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(*_dialect, ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-
-	// This is a tuning parameter, but actually just prevents infinite loops.
-	size_t stackCompressorMaxIterations = 16;
-	FunctionGrouper{}(ast);
-	// We ignore the return value because we will get a much better error
-	// message once we perform code generation.
-	StackCompressor::run(_dialect, ast, _optimizeStackAllocation, stackCompressorMaxIterations);
-	BlockFlattener{}(ast);
-	DeadCodeEliminator{}(ast);
-
-	FunctionGrouper{}(ast);
-	VarNameCleaner{ast, *_dialect, reservedIdentifiers}(ast);
+	{
+		// Make source short and pretty.
+		ScopedTimer phaseTimer("cleanup");
+
+		runStep("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+		runStep("Rematerialiser", [&]() { Rematerialiser::run(*_dialect, ast, {}, _meter); });
+		runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
+		runStep("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+		runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
+		runStep("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+		runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
+
+		runStep("SSAReverser", [&]() { SSAReverser::run(ast); });
+		runStep("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{*_dialect}(ast); });
+		runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
+
+		runStep("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+		runStep("Rematerialiser", [&]() { Rematerialiser::run(*_dialect, ast, {}, _meter); });
+		runStep("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers); });
+	}
+
+	{
+		ScopedTimer phaseTimer("stack compression");
+		// This is a tuning parameter, but actually just prevents infinite loops.
+		size_t stackCompressorMaxIterations = 16;
+		runStep("FunctionGrouper", [&]() { FunctionGrouper{}(ast); });
+		// We ignore the return value because we will get a much better error
+		// message once we perform code generation.
+		runStep("StackCompressor", [&]() {
+			StackCompressor::run(_dialect, ast, _optimizeStackAllocation, stackCompressorMaxIterations, _meter);
+		});
+	}
+	runStep("BlockFlattener", [&]() { BlockFlattener{}(ast); });
+	runStep("DeadCodeEliminator", [&]() { DeadCodeEliminator{}(ast); });
+
+	runStep("FunctionGrouper", [&]() { FunctionGrouper{}(ast); });
+	runStep("VarNameCleaner", [&]() { VarNameCleaner{ast, *_dialect, reservedIdentifiers}(ast); });
 	yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, ast);
 
 	_ast = std::move(ast);
@@ -31,15 +31,18 @@ namespace yul
 
 struct AsmAnalysisInfo;
 struct Dialect;
+class GasMeter;
 
 /**
- * Optimiser suite that combines all steps and also provides the settings for the heuristics
+ * Optimiser suite that combines all steps and also provides the settings for the heuristics.
+ * The gas meter is used by the steps that trade code size against runtime gas, if provided.
  */
 class OptimiserSuite
 {
 public:
 	static void run(
 		std::shared_ptr<Dialect> const& _dialect,
+		GasMeter const* _meter,
 		Block& _ast,
 		AsmAnalysisInfo const& _analysisInfo,
 		bool _optimizeStackAllocation,
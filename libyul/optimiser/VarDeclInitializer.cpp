@@ -29,11 +29,11 @@ void VarDeclInitializer::operator()(Block& _block)
 {
 	ASTModifier::operator()(_block);
 
-	static Expression const zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
+	Expression const zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 
 	using OptionalStatements = boost::optional<vector<Statement>>;
 	GenericFallbackReturnsVisitor<OptionalStatements, VariableDeclaration> visitor{
-		[](VariableDeclaration& _varDecl) -> OptionalStatements
+		[&](VariableDeclaration& _varDecl) -> OptionalStatements
 		{
 			if (_varDecl.value)
 				return {};
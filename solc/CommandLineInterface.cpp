@@ -36,6 +36,7 @@
 
 #include <libyul/AssemblyStack.h>
 
+#include <libevmasm/ExecutionProfile.h>
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
 
@@ -48,6 +49,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
 
 #include <memory>
 
@@ -109,12 +111,15 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
+static string const g_strCacheSize = "cache-size";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
 static string const g_strEVM = "evm";
 static string const g_strEVM15 = "evm15";
 static string const g_strEVMVersion = "evm-version";
+static string const g_strExecutionProfile = "execution-profile";
 static string const g_streWasm = "ewasm";
 static string const g_strGas = "gas";
 static string const g_strHelp = "help";
@@ -143,6 +148,7 @@ static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
+static string const g_strTimePasses = "time-passes";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
@@ -161,8 +167,11 @@ static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
+static string const g_argCacheSize = g_strCacheSize;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
+static string const g_argExecutionProfile = g_strExecutionProfile;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
@@ -182,6 +191,7 @@ static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
+static string const g_argTimePasses = g_strTimePasses;
 static string const g_argVersion = g_strVersion;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
@@ -259,6 +269,57 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 	return false;
 }
 
+/// @returns false if all requested outputs are available after analysis. If no output is
+/// requested at all, code is still generated so that code generation errors are reported.
+static bool needsCodeGeneration(po::variables_map const& _args)
+{
+	for (string const& arg: {
+		g_argAsm,
+		g_argAsmJson,
+		g_argAst,
+		g_argBinary,
+		g_argBinaryRuntime,
+		g_argGas,
+		g_argIR,
+		g_argOpcodes
+	})
+		if (_args.count(arg))
+			return true;
+
+	if (_args.count(g_argCombinedJson))
+	{
+		set<string> requests;
+		boost::split(requests, _args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
+		for (string const& request: {g_strAsm, g_strBinary, g_strBinaryRuntime, g_strOpcodes, g_strSrcMap, g_strSrcMapRuntime})
+			if (requests.count(request))
+				return true;
+	}
+
+	for (string const& arg: {
+		g_argAbi,
+		g_argAstJson,
+		g_argAstCompactJson,
+		g_argCombinedJson,
+		g_argMetadata,
+		g_argNatspecUser,
+		g_argNatspecDev,
+		g_argSignatureHashes
+	})
+		if (_args.count(arg))
+			return false;
+	return true;
+}
+
+static shared_ptr<CompilationCache> createCache(po::variables_map const& _args)
+{
+	if (!_args.count(g_argCacheDir))
+		return nullptr;
+	return make_shared<CompilationCache>(
+		_args[g_argCacheDir].as<string>(),
+		uint64_t(_args[g_argCacheSize].as<unsigned>()) * 1024 * 1024
+	);
+}
+
 void CommandLineInterface::handleBinary(string const& _contract)
 {
 	if (m_args.count(g_argBinary))
@@ -633,6 +694,12 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_argExecutionProfile.c_str(),
+			po::value<string>()->value_name("file"),
+			"Optimize the code covered by the execution counts in the given JSON file for these counts "
+			"instead of the number of runs and dispatch frequently called functions first. Requires --optimize."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -658,6 +725,23 @@ Allowed options)",
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Look up and store Standard JSON compilation results in the given directory. "
+			"Results are addressed by the hash of the compiler version, sources and settings."
+		)
+		(
+			g_argCacheSize.c_str(),
+			po::value<unsigned>()->value_name("megabytes")->default_value(1024),
+			"Maximum size of the compilation cache. Least recently used results are removed "
+			"when it is exceeded. Zero means unlimited."
+		)
+		(
+			g_argTimePasses.c_str(),
+			"Print the time spent in the individual compiler phases and the peak memory usage "
+			"to standard error after compilation."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and --optimize and assumes input is assembly."
@@ -834,6 +918,7 @@ bool CommandLineInterface::processInput()
 	{
 		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
+		compiler.setCache(createCache(m_args));
 		sout() << compiler.compile(std::move(input)) << endl;
 		return true;
 	}
@@ -922,7 +1007,6 @@ bool CommandLineInterface::processInput()
 		if (m_args.count(g_argLibraries))
 			m_compiler->setLibraries(m_libraries);
 		m_compiler->setEVMVersion(m_evmVersion);
-		// TODO: Perhaps we should not compile unless requested
 
 		m_compiler->enableIRGeneration(m_args.count(g_argIR));
 
@@ -930,9 +1014,47 @@ bool CommandLineInterface::processInput()
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		if (m_args.count(g_argExecutionProfile))
+		{
+			if (!m_args.count(g_argOptimize))
+			{
+				serr() << "Option --" << g_argExecutionProfile << " requires --" << g_argOptimize << "." << endl;
+				return false;
+			}
+			string const path = m_args[g_argExecutionProfile].as<string>();
+			if (!boost::filesystem::is_regular_file(path))
+			{
+				serr() << "Execution profile \"" << path << "\" not found." << endl;
+				return false;
+			}
+			Json::Value json;
+			string errors;
+			if (!jsonParseStrict(readFileAsString(path), json, &errors))
+			{
+				serr() << "Invalid execution profile: " << errors << endl;
+				return false;
+			}
+			auto profile = eth::ExecutionProfile::fromJson(json);
+			if (profile.type() == typeid(string))
+			{
+				serr() << "Invalid execution profile: " << boost::get<string>(profile) << endl;
+				return false;
+			}
+			settings.executionProfile = make_shared<eth::ExecutionProfile const>(boost::get<eth::ExecutionProfile>(std::move(profile)));
+		}
 		m_compiler->setOptimiserSettings(settings);
 
-		bool successful = m_compiler->compile();
+		if (m_args.count(g_argTimePasses))
+		{
+			Profiler::instance().reset();
+			Profiler::instance().enable();
+		}
+		bool successful = needsCodeGeneration(m_args) ? m_compiler->compile() : m_compiler->parseAndAnalyze();
+		if (m_args.count(g_argTimePasses))
+		{
+			Profiler::instance().enable(false);
+			serr() << Profiler::instance().toString();
+		}
 
 		for (auto const& error: m_compiler->errors())
 		{
@@ -1088,20 +1210,22 @@ void CommandLineInterface::handleAst(string const& _argStr)
 		for (auto const& sourceCode: m_sourceCodes)
 			asts.push_back(&m_compiler->ast(sourceCode.first));
 		map<ASTNode const*, eth::GasMeter::GasConsumption> gasCosts;
-		for (auto const& contract : m_compiler->contractNames())
-		{
-			if (auto const* assemblyItems = m_compiler->runtimeAssemblyItems(contract))
+		// Only the plain AST output is annotated with gas costs, the JSON outputs
+		// are available after analysis.
+		if (_argStr == g_argAst)
+			for (auto const& contract : m_compiler->contractNames())
 			{
-				auto ret = GasEstimator::breakToStatementLevel(
-					GasEstimator(m_evmVersion).structuralEstimation(*assemblyItems, asts),
-					asts
-				);
-				for (auto const& it: ret)
-					gasCosts[it.first] += it.second;
+				if (auto const* assemblyItems = m_compiler->runtimeAssemblyItems(contract))
+				{
+					auto ret = GasEstimator::breakToStatementLevel(
+						GasEstimator(m_evmVersion).structuralEstimation(*assemblyItems, asts),
+						asts
+					);
+					for (auto const& it: ret)
+						gasCosts[it.first] += it.second;
+				}
 			}
 
-		}
-
 		bool legacyFormat = !m_args.count(g_argAstCompactJson);
 		if (m_args.count(g_argOutputDir))
 		{
@@ -81,6 +81,35 @@ BOOST_AUTO_TEST_CASE(test_format_number)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(test_u256_conversions)
+{
+	vector<u256> values{0, 1, 0xff, 0x100, 0x0102030405060708, u256(1) << 64, u256(0x1234) << 100, ~u256(0)};
+	u256 v = 7;
+	for (size_t i = 0; i < 100; ++i, v = v * 257 + 13)
+		values.push_back(v);
+	for (u256 const& value: values)
+	{
+		bigint wide = value;
+		bytes big = toBigEndian(value);
+		bytes reference(32);
+		toBigEndian(wide, reference);
+		BOOST_CHECK(big == reference);
+		BOOST_CHECK(fromBigEndian<u256>(big) == value);
+		BOOST_CHECK(fromBigEndian<bigint>(big) == wide);
+		BOOST_CHECK(toCompactBigEndian(value) == toCompactBigEndian(wide));
+		BOOST_CHECK(toCompactBigEndian(value, 3) == toCompactBigEndian(wide, 3));
+		BOOST_CHECK(fromBigEndian<u256>(toCompactBigEndian(value)) == value);
+		BOOST_CHECK_EQUAL(bytesRequired(value), bytesRequired(wide));
+		ostringstream hex;
+		hex << std::hex << value;
+		BOOST_CHECK_EQUAL(toCompactHexWithPrefix(value), "0x" + hex.str());
+	}
+	// Truncation to fewer bytes keeps the least significant ones.
+	bytes shortBuffer(3, 0);
+	toBigEndian(u256(0x0102030405), shortBuffer);
+	BOOST_CHECK(shortBuffer == bytes({0x03, 0x04, 0x05}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
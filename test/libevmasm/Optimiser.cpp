@@ -24,11 +24,19 @@
 
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/SuperoptimisedRules.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ConstantOptimiser.h>
+#include <libevmasm/ExecutionProfile.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/Inliner.h>
 #include <libevmasm/Assembly.h>
 
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <string>
@@ -112,6 +120,25 @@ namespace
 		AssemblyItems output = CFG(_input);
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
+
+	AssemblyItems CSEAcrossBlocks(AssemblyItems const& _input, size_t _runs = 200)
+	{
+		Assembly assembly;
+		for (AssemblyItem const& item: _input)
+			assembly.append(item);
+		Assembly::OptimiserSettings settings;
+		settings.runCSE = true;
+		settings.evmVersion = dev::test::Options::get().evmVersion();
+		settings.expectedExecutionsPerDeployment = _runs;
+		assembly.optimise(settings);
+		return assembly.items();
+	}
+
+	void checkCSEAcrossBlocks(AssemblyItems const& _input, AssemblyItems const& _expectation)
+	{
+		AssemblyItems output = CSEAcrossBlocks(_input);
+		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
+	}
 }
 
 BOOST_AUTO_TEST_SUITE(Optimiser)
@@ -773,6 +800,231 @@ BOOST_AUTO_TEST_CASE(control_flow_graph_do_not_remove_returned_to)
 	checkCFG(input, {u256(2)});
 }
 
+BOOST_AUTO_TEST_CASE(cse_across_blocks_storage)
+{
+	// The value stored before the branch is known in both branches.
+	AssemblyItems input{
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(0),
+		Instruction::SLOAD,
+		u256(1),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		u256(2),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	checkCSEAcrossBlocks(input, {
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(7),
+		u256(1),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		u256(7),
+		u256(2),
+		Instruction::SSTORE,
+		Instruction::STOP
+	});
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_join)
+{
+	// Memory is only known at the join if it is the same on all paths.
+	AssemblyItems input{
+		u256(7),
+		u256(0),
+		Instruction::MSTORE,
+		u256(8),
+		u256(0x20),
+		Instruction::MSTORE,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(9),
+		u256(0x20),
+		Instruction::MSTORE,
+		AssemblyItem(Tag, 1),
+		u256(0x20),
+		Instruction::MLOAD,
+		u256(0),
+		Instruction::MLOAD,
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems output = CSEAcrossBlocks(input);
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		u256(0x20),
+		Instruction::MLOAD,
+		u256(7),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	BOOST_REQUIRE(output.size() >= expectation.size());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		expectation.begin(), expectation.end(),
+		output.end() - expectation.size(), output.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_escaping_tag)
+{
+	// Tag 1 is pushed as a return address and might thus be jumped to from anywhere.
+	AssemblyItems input{
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		u256(1),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(0),
+		Instruction::SLOAD,
+		u256(2),
+		Instruction::SSTORE,
+		Instruction::JUMP
+	};
+	checkCSEAcrossBlocks(input, {
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		u256(1),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(7),
+		u256(2),
+		Instruction::SSTORE,
+		Instruction::JUMP
+	});
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_stack)
+{
+	// The constant on the stack is known after the conditional jump,
+	// so the hash of the memory it is stored to can be computed.
+	AssemblyItems input{
+		u256(2),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::INVALID,
+		AssemblyItem(Tag, 1),
+		Instruction::DUP1,
+		u256(0),
+		Instruction::MSTORE,
+		u256(0x20),
+		u256(0),
+		Instruction::KECCAK256,
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems output = CSEAcrossBlocks(input);
+	BOOST_CHECK(count(output.begin(), output.end(), AssemblyItem(Instruction::KECCAK256)) == 0);
+	u256 hash(h256::Arith(keccak256(toBigEndian(u256(2)))));
+	BOOST_CHECK(count(output.begin(), output.end(), AssemblyItem(hash)) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_stack_low_runs)
+{
+	// Storing the hash is more expensive than computing it if the code is rarely run.
+	AssemblyItems input{
+		u256(2),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::INVALID,
+		AssemblyItem(Tag, 1),
+		Instruction::DUP1,
+		u256(0),
+		Instruction::MSTORE,
+		u256(0x20),
+		u256(0),
+		Instruction::KECCAK256,
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems output = CSEAcrossBlocks(input, 1);
+	BOOST_CHECK(count(output.begin(), output.end(), AssemblyItem(Instruction::KECCAK256)) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_memory_after_codecopy)
+{
+	// Copying to memory only invalidates the knowledge about the memory it copies to.
+	AssemblyItems input{
+		u256(0x80),
+		u256(0x40),
+		Instruction::MSTORE,
+		u256(0x20),
+		u256(0),
+		u256(0),
+		Instruction::CODECOPY,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::INVALID,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::MLOAD,
+		u256(0x40),
+		Instruction::MLOAD,
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems output = CSEAcrossBlocks(input);
+	BOOST_CHECK(count(output.begin(), output.end(), AssemblyItem(Instruction::MLOAD)) == 1);
+	BOOST_CHECK(count(output.begin(), output.end(), AssemblyItem(u256(0x80))) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_knowledge_tag_referenced_from_outside)
+{
+	AssemblyItems input{
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::STOP
+	};
+	BOOST_CHECK_EQUAL(ControlFlowGraph(input).knowledgeAtBlockStarts({}, true).count(6), 1);
+	BOOST_CHECK_EQUAL(ControlFlowGraph(input).knowledgeAtBlockStarts({1}, true).count(6), 0);
+}
+
 BOOST_AUTO_TEST_CASE(block_deduplicator)
 {
 	AssemblyItems input{
@@ -1075,6 +1327,227 @@ BOOST_AUTO_TEST_CASE(peephole_iszero_iszero_jumpi)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(peephole_superoptimised)
+{
+	AssemblyItems items{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(0x20),
+		Instruction::CALLDATALOAD,
+		Instruction::DUP2,
+		Instruction::ADD,
+		Instruction::SWAP1,
+		Instruction::POP,
+		u256(0),
+		Instruction::SSTORE
+	};
+	AssemblyItems expectation{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(0x20),
+		Instruction::CALLDATALOAD,
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_superoptimised_rules_equivalent)
+{
+	// Every generated rule is shorter, not more expensive and results in the same stack.
+	auto gas = [](vector<Instruction> const& _instructions) {
+		unsigned gas = 0;
+		for (Instruction instruction: _instructions)
+			gas += GasMeter::runGas(instruction);
+		return gas;
+	};
+	for (SuperoptimisedRule const& rule: superoptimisedRules())
+	{
+		BOOST_CHECK(rule.replacement.size() < rule.pattern.size());
+		BOOST_CHECK(gas(rule.replacement) <= gas(rule.pattern));
+		auto classes = make_shared<ExpressionClasses>();
+		KnownState pattern(classes);
+		KnownState replacement(classes);
+		int depth = 0;
+		auto feed = [&](KnownState& _state, vector<Instruction> const& _instructions) {
+			for (Instruction instruction: _instructions)
+			{
+				depth = max(depth, instructionInfo(instruction).args - _state.stackHeight());
+				_state.feedItem(AssemblyItem(instruction), true);
+			}
+		};
+		feed(pattern, rule.pattern);
+		feed(replacement, rule.replacement);
+		BOOST_REQUIRE_EQUAL(pattern.stackHeight(), replacement.stackHeight());
+		for (int height = 1 - depth; height <= pattern.stackHeight(); ++height)
+			BOOST_CHECK(pattern.stackElement(height, {}) == replacement.stackElement(height, {}));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(inliner)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		u256(2),
+		AssemblyItem(PushTag, 2),
+		jumpInto,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		Instruction::ADD,
+		Instruction::SWAP1,
+		jumpOutOf
+	};
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 1),
+		u256(2),
+		Instruction::CALLVALUE,
+		Instruction::ADD,
+		Instruction::SWAP1,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		Instruction::ADD,
+		Instruction::SWAP1,
+		jumpOutOf
+	};
+	BOOST_REQUIRE(Inliner(items, {}, 200, false, dev::test::Options::get().evmVersion()).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	// The former jump out of the function is now an ordinary jump.
+	BOOST_CHECK(items[5].getJumpType() == AssemblyItem::JumpType::Ordinary);
+}
+
+BOOST_AUTO_TEST_CASE(inliner_large_function_few_runs)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	AssemblyItems items;
+	for (unsigned call = 0; call < 3; ++call)
+		items += AssemblyItems{AssemblyItem(PushTag, 10 + call), AssemblyItem(PushTag, 1), jumpInto, AssemblyItem(Tag, 10 + call)};
+	items += AssemblyItems{Instruction::STOP, AssemblyItem(Tag, 1)};
+	for (unsigned i = 0; i < 20; ++i)
+		items += AssemblyItems{Instruction::CALLVALUE, Instruction::POP};
+	items.push_back(jumpOutOf);
+	AssemblyItems original = items;
+
+	// Three copies of the body do not pay off if the code is only run once...
+	BOOST_CHECK(!Inliner(items, {}, 1, false, dev::test::Options::get().evmVersion()).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		original.begin(), original.end()
+	);
+	// ...but they do if it is run often.
+	BOOST_CHECK(Inliner(items, {}, 1000, false, dev::test::Options::get().evmVersion()).optimise());
+}
+
+BOOST_AUTO_TEST_CASE(inliner_no_ordinary_jumps_or_recursion)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	AssemblyItems items{
+		AssemblyItem(PushTag, 3),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		AssemblyItem(PushTag, 4),
+		AssemblyItem(PushTag, 2),
+		jumpInto,
+		AssemblyItem(Tag, 4),
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		Instruction::CALLVALUE,
+		Instruction::POP,
+		jumpOutOf,
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 2),
+		Instruction::POP,
+		jumpOutOf
+	};
+	AssemblyItems original = items;
+	BOOST_CHECK(!Inliner(items, {}, 200, false, dev::test::Options::get().evmVersion()).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		original.begin(), original.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_execution_profile)
+{
+	SourceLocation location{0, 10, make_shared<CharStream>("", "a.sol")};
+	auto assembly = [&]() {
+		Assembly a;
+		a.setSourceLocation(location);
+		a.append(~u256(0xff));
+		a.append(Instruction::POP);
+		return a;
+	};
+	langutil::EVMVersion const evmVersion = dev::test::Options::get().evmVersion();
+
+	// Computing the constant is cheaper unless the code is run very often...
+	Assembly cold = assembly();
+	BOOST_CHECK(ConstantOptimisationMethod::optimiseConstants(false, 200, evmVersion, cold) > 0);
+
+	// ...which the profile says it is.
+	ExecutionProfile profile;
+	profile.setLocationCount("a.sol", 0, 20, 1000000);
+	Assembly hot = assembly();
+	BOOST_CHECK_EQUAL(ConstantOptimisationMethod::optimiseConstants(false, 200, evmVersion, hot, &profile), 0);
+
+	// Ranges of other sources or not containing the location do not apply.
+	ExecutionProfile otherProfile;
+	otherProfile.setLocationCount("b.sol", 0, 20, 1000000);
+	otherProfile.setLocationCount("a.sol", 5, 20, 1000000);
+	Assembly other = assembly();
+	BOOST_CHECK(ConstantOptimisationMethod::optimiseConstants(false, 200, evmVersion, other, &otherProfile) > 0);
+}
+
+BOOST_AUTO_TEST_CASE(execution_profile_json)
+{
+	Json::Value json;
+	json["functions"]["f()"] = 7;
+	json["locations"]["a.sol"]["0:100"] = 10;
+	json["locations"]["a.sol"]["20:30"] = 3;
+	auto result = ExecutionProfile::fromJson(json);
+	BOOST_REQUIRE(result.type() == typeid(ExecutionProfile));
+	ExecutionProfile const& profile = boost::get<ExecutionProfile>(result);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(profile.toJson()), jsonCompactPrint(json));
+	BOOST_CHECK_EQUAL(*profile.functionCount("f()"), 7);
+	BOOST_CHECK(!profile.functionCount("g()"));
+
+	auto source = make_shared<CharStream>("", "a.sol");
+	// The smallest containing range is used.
+	BOOST_CHECK_EQUAL(*profile.locationCount({25, 30, source}), 3);
+	BOOST_CHECK_EQUAL(*profile.locationCount({10, 30, source}), 10);
+	BOOST_CHECK(!profile.locationCount({90, 110, source}));
+	BOOST_CHECK(!profile.locationCount({25, 30, make_shared<CharStream>("", "b.sol")}));
+
+	json["locations"]["a.sol"]["20"] = 3;
+	BOOST_CHECK(ExecutionProfile::fromJson(json).type() == typeid(string));
+	json["locations"]["a.sol"].removeMember("20");
+	json["functions"]["f()"] = -1;
+	BOOST_CHECK(ExecutionProfile::fromJson(json).type() == typeid(string));
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal)
 {
 	AssemblyItems items{
@@ -141,6 +141,91 @@ BOOST_AUTO_TEST_CASE(single_callvaluecheck)
 	BOOST_CHECK_EQUAL(bytecodeSizePayable - bytecodeSizeNonpayable, 26);
 }
 
+BOOST_AUTO_TEST_CASE(weighted_dispatch)
+{
+	string sourceCode = R"(
+		contract C {
+			function f0() public pure returns (uint) { return 0; }
+			function f1() public pure returns (uint) { return 1; }
+			function f2() public pure returns (uint) { return 2; }
+			function f3() public pure returns (uint) { return 3; }
+			function f4() public pure returns (uint) { return 4; }
+			function f5() public pure returns (uint) { return 5; }
+			function f6() public pure returns (uint) { return 6; }
+			function f7() public pure returns (uint) { return 7; }
+			function f8() public pure returns (uint) { return 8; }
+			function f9() public pure returns (uint) { return 9; }
+		}
+	)";
+	auto callGas = [&]() {
+		compileAndRun(sourceCode);
+		BOOST_CHECK(callContractFunction("f9()") == encodeArgs(9));
+		return m_gasUsed;
+	};
+	// f9() has the largest selector, so the uniform selector splits once and then
+	// compares against all five selectors in the upper half.
+	u256 uniformGas = callGas();
+
+	auto profile = make_shared<eth::ExecutionProfile>();
+	profile->setFunctionCount("f9()", 100000);
+	m_optimiserSettings.executionProfile = profile;
+	// Now it is compared against first.
+	u256 weightedGas = callGas();
+	m_optimiserSettings.executionProfile.reset();
+
+	BOOST_CHECK(weightedGas < uniformGas);
+	// Each comparison is "dup1 push4 eq push jumpi".
+	BOOST_CHECK_EQUAL(uniformGas - weightedGas, 5 * 22);
+}
+
+BOOST_AUTO_TEST_CASE(packed_array_copy)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint8[] packed;
+			uint256[] words;
+			uint8[64] packedStatic;
+			uint8[64] packedStaticCopy;
+			function copyPacked(uint8[] calldata _values) external { packed = _values; }
+			function readPacked(uint8[] calldata _values) external {}
+			function copyWords(uint256[] calldata _values) external { words = _values; }
+			function readWords(uint256[] calldata _values) external {}
+			function fillStatic() external { packedStatic[0] = 1; packedStatic[63] = 2; }
+			function copyStatic() external { packedStaticCopy = packedStatic; }
+		}
+	)";
+	compileAndRun(sourceCode);
+	// Both arrays occupy two slots. Subtract the cost of calls with the same
+	// data that do not copy.
+	auto copyGas = [&](string const& _copy, string const& _read, vector<u256> const& _values) {
+		callContractFunction(_read, u256(0x20), _values.size(), _values);
+		u256 readGas = m_gasUsed;
+		callContractFunction(_copy, u256(0x20), _values.size(), _values);
+		return m_gasUsed - readGas;
+	};
+	vector<u256> packedValues;
+	for (unsigned i = 1; i <= 64; ++i)
+		packedValues.push_back(i);
+	u256 packedGas = copyGas("copyPacked(uint8[])", "readPacked(uint8[])", packedValues);
+	u256 wordsGas = copyGas("copyWords(uint256[])", "readWords(uint256[])", {1, 2});
+	// Every slot is stored once, so only the work of combining the values remains.
+	BOOST_CHECK_MESSAGE(
+		packedGas < wordsGas + 64 * 120,
+		"Gas used: " + packedGas.str() + " - for two words: " + wordsGas.str()
+	);
+
+	// Copies between small static arrays are unrolled and only load and store the two slots.
+	callContractFunction("fillStatic()");
+	callContractFunction("copyStatic()");
+	u256 staticGas = m_gasUsed;
+	callContractFunction("copyStatic()");
+	BOOST_CHECK(m_gasUsed < staticGas);
+	BOOST_CHECK_MESSAGE(
+		staticGas < 21000 + 2 * 20000 + 2 * 200 + 2000,
+		"Gas used: " + staticGas.str()
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -25,6 +25,8 @@
 #include <libdevcore/JSON.h>
 #include <test/Metadata.h>
 
+#include <boost/filesystem.hpp>
+
 using namespace std;
 using namespace dev::eth;
 
@@ -604,6 +606,35 @@ BOOST_AUTO_TEST_CASE(output_selection_dependent_contract_with_import)
 	BOOST_CHECK_EQUAL(dev::jsonCompactPrint(contract["abi"]), "[{\"constant\":false,\"inputs\":[],\"name\":\"f\",\"outputs\":[],\"payable\":false,\"stateMutability\":\"nonpayable\",\"type\":\"function\"}]");
 }
 
+BOOST_AUTO_TEST_CASE(output_selection_code_generation_on_demand)
+{
+	// Code generation for A fails, so it must only be attempted if binaries of A are requested.
+	string const sources = R"(
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint a, uint b, uint c, uint d, uint e, uint f, uint g, uint h, uint i, uint j, uint k, uint l, uint m, uint n, uint o, uint p, uint q) public pure returns (uint) { return a; } } contract B { }"
+			}
+		}
+	)";
+	auto compileWithSelection = [&](string const& _outputSelection) {
+		return compile(R"({ "language": "Solidity", "settings": { "outputSelection": )" + _outputSelection + "}, " + sources + "}");
+	};
+
+	Json::Value result = compileWithSelection(R"({ "*": { "*": [ "evm.bytecode.object" ] } })");
+	BOOST_CHECK(!containsAtMostWarnings(result));
+
+	result = compileWithSelection(R"({ "fileA": { "A": [ "abi" ], "B": [ "evm.bytecode.object" ] } })");
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(getContractResult(result, "fileA", "A")["abi"].isArray());
+	BOOST_CHECK(!getContractResult(result, "fileA", "B")["evm"]["bytecode"]["object"].asString().empty());
+
+	result = compileWithSelection(R"({ "*": { "": [ "ast" ], "*": [ "abi", "evm.methodIdentifiers" ], "B": [ "evm.bytecode.object" ] } })");
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"]["fileA"]["ast"].isObject());
+	BOOST_CHECK(getContractResult(result, "fileA", "A")["evm"]["methodIdentifiers"].isObject());
+	BOOST_CHECK(!getContractResult(result, "fileA", "B")["evm"]["bytecode"]["object"].asString().empty());
+}
+
 BOOST_AUTO_TEST_CASE(filename_with_colon)
 {
 	char const* input = R"(
@@ -981,6 +1012,7 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 				"constantOptimizer" : true,
 				"cse" : false,
 				"deduplicate" : true,
+				"inliner" : true,
 				"jumpdestRemover" : true,
 				"orderLiterals" : false,
 				"peephole" : true,
@@ -1014,6 +1046,7 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["details"]["constantOptimizer"].asBool() == true);
 	BOOST_CHECK(optimizer["details"]["cse"].asBool() == false);
 	BOOST_CHECK(optimizer["details"]["deduplicate"].asBool() == true);
+	BOOST_CHECK(optimizer["details"]["inliner"].asBool() == true);
 	BOOST_CHECK(optimizer["details"]["jumpdestRemover"].asBool() == true);
 	BOOST_CHECK(optimizer["details"]["orderLiterals"].asBool() == false);
 	BOOST_CHECK(optimizer["details"]["peephole"].asBool() == true);
@@ -1021,10 +1054,100 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["details"]["yulDetails"].isObject());
 	BOOST_CHECK(optimizer["details"]["yulDetails"].getMemberNames() == vector<string>{"stackAllocation"});
 	BOOST_CHECK(optimizer["details"]["yulDetails"]["stackAllocation"].asBool() == true);
-	BOOST_CHECK_EQUAL(optimizer["details"].getMemberNames().size(), 8);
+	BOOST_CHECK_EQUAL(optimizer["details"].getMemberNames().size(), 9);
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_execution_profile)
+{
+	char const* input = R"DELIMITER(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.deployedBytecode.object" ] }
+			},
+			"optimizer": {
+				"enabled": true,
+				"executionProfile": { "functions": { "g()": 1000 } }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public {} function g() public {} }"
+			}
+		}
+	}
+	)DELIMITER";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(optimizer["enabled"].asBool() == true);
+	BOOST_CHECK(optimizer["executionProfile"]["functions"]["g()"].asUInt() == 1000);
+
+	// The frequently called g() = 0xe2179b8e is dispatched before f() = 0x26121ff0.
+	string code = contract["evm"]["deployedBytecode"]["object"].asString();
+	size_t g = code.find("63e2179b8e14");
+	size_t f = code.find("6326121ff014");
+	BOOST_REQUIRE(g != string::npos && f != string::npos);
+	BOOST_CHECK(g < f);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_invalid_execution_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": {
+				"executionProfile": { "locations": { "fileA": { "10": 1000 } } }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"Invalid source range \"10\" in execution profile, expected \"<start>:<length>\"."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_execution_profile_without_optimizer)
+{
+	char const* input = R"DELIMITER(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": {
+				"enabled": false,
+				"executionProfile": { "functions": { "g()": 1000 } }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)DELIMITER";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"The \"executionProfile\" setting requires the optimizer to be enabled."
+	));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1058,6 +1181,50 @@ BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 	BOOST_CHECK(dev::test::isValidMetadata(contract["metadata"].asString()));
 }
 
+BOOST_AUTO_TEST_CASE(debug_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"debug": { "profile": true },
+			"outputSelection": {
+				"fileA": { "A": [ "evm.bytecode.object" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() pure public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& profile = result["profile"];
+	BOOST_REQUIRE(profile.isObject());
+	BOOST_REQUIRE(profile["phases"].isArray());
+	set<string> phases;
+	for (auto const& phase: profile["phases"])
+	{
+		BOOST_CHECK_EQUAL(phase["calls"].asUInt(), 1);
+		phases.insert(phase["name"].asString());
+	}
+	BOOST_CHECK((phases == set<string>{"parsing", "analysis", "code generation"}));
+	BOOST_CHECK(profile["counters"].isObject());
+	BOOST_CHECK(profile["peakMemory"].isUInt64());
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+	parsedInput["settings"]["debug"]["profile"] = 1;
+	result = solidity::StandardCompiler().compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.debug.profile\" must be Boolean"));
+	parsedInput["settings"]["debug"] = Json::objectValue;
+	result = solidity::StandardCompiler().compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("profile"));
+}
+
 BOOST_AUTO_TEST_CASE(common_pattern)
 {
 	char const* input = R"(
@@ -1156,6 +1323,74 @@ BOOST_AUTO_TEST_CASE(use_stack_optimization)
 	BOOST_CHECK(result["errors"][0]["type"] == "InternalCompilerError");
 }
 
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "abi", "evm.bytecode.object" ] }
+			}
+		},
+		"sources": {
+			"fileA": { "content": "import \"fileB\"; contract A is B { function f() public {} }" }
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+
+	string importedSource = "contract B { function g() public {} }";
+	size_t reads = 0;
+	ReadCallback::Callback readFile = [&](string const& _path) {
+		reads++;
+		BOOST_CHECK_EQUAL(_path, "fileB");
+		return ReadCallback::Result{true, importedSource};
+	};
+
+	boost::filesystem::path directory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	auto cache = make_shared<CompilationCache>(directory);
+	solidity::StandardCompiler compiler(readFile);
+	compiler.setCache(cache);
+
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(getContractResult(result, "fileA", "A")["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK_EQUAL(reads, 1);
+
+	// Cache hit: the import is only re-read for validation.
+	// Cached numbers are parsed back as signed integers, so the printed forms are compared.
+	BOOST_CHECK_EQUAL(jsonCompactPrint(compiler.compile(parsedInput)), jsonCompactPrint(result));
+	BOOST_CHECK_EQUAL(reads, 2);
+
+	// Changed import invalidates the entry.
+	importedSource = "contract B { function h() public {} }";
+	Json::Value changed = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(changed));
+	BOOST_CHECK(changed != result);
+
+	// Different output selection is a different entry.
+	parsedInput["settings"]["outputSelection"]["fileA"]["A"] = Json::arrayValue;
+	parsedInput["settings"]["outputSelection"]["fileA"]["A"].append("abi");
+	Json::Value abiOnly = compiler.compile(parsedInput);
+	BOOST_CHECK(!getContractResult(abiOnly, "fileA", "A").isMember("evm"));
+
+	// A size limit of one byte evicts everything on the next store but never breaks compilation.
+	parsedInput["settings"]["outputSelection"]["fileA"]["A"][0] = "evm.bytecode.object";
+	solidity::StandardCompiler limitedCompiler(readFile);
+	limitedCompiler.setCache(make_shared<CompilationCache>(directory, 1));
+	Json::Value bytecodeOnly = limitedCompiler.compile(parsedInput);
+	BOOST_CHECK(
+		getContractResult(bytecodeOnly, "fileA", "A")["evm"]["bytecode"]["object"] ==
+		getContractResult(changed, "fileA", "A")["evm"]["bytecode"]["object"]
+	);
+	BOOST_CHECK(boost::filesystem::is_empty(directory));
+
+	boost::filesystem::remove_all(directory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
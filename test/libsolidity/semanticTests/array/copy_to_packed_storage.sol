@@ -0,0 +1,52 @@
+contract C {
+    uint8[] a;
+    uint24[] b;
+    int16[] c;
+    bytes3[] d;
+    uint128[3] s;
+    uint128[6] t;
+
+    function slots(uint256 _slot) internal view returns (uint256 first, uint256 second) {
+        uint256 data = uint256(keccak256(abi.encode(_slot)));
+        assembly {
+            first := sload(data)
+            second := sload(add(data, 1))
+        }
+    }
+    function setA(uint8[] memory _x) public returns (uint256, uint256, uint256) {
+        a = _x;
+        (uint256 first, uint256 second) = slots(0);
+        return (a.length, first, second);
+    }
+    function setB(uint24[] calldata _x) external returns (uint256, uint256, uint256) {
+        b = _x;
+        (uint256 first, uint256 second) = slots(1);
+        return (b.length, first, second);
+    }
+    function setC(int16[] calldata _x) external returns (uint256, int16) {
+        c = _x;
+        (uint256 first,) = slots(2);
+        return (first, c[0]);
+    }
+    function setD(bytes3[] memory _x) public returns (uint256, bytes3) {
+        d = _x;
+        (uint256 first,) = slots(3);
+        return (first, d[1]);
+    }
+    function copyStatic() public returns (uint128, uint128, uint128, uint128) {
+        s[0] = 1;
+        s[2] = 3;
+        t[3] = 4;
+        t[5] = 6;
+        t = s;
+        return (t[0], t[2], t[3], t[5]);
+    }
+}
+// ----
+// setA(uint8[]): 0x20, 33, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33 -> 33, 0x201f1e1d1c1b1a191817161514131211100f0e0d0c0b0a090807060504030201, 0x21
+// setA(uint8[]): 0x20, 2, 7, 8 -> 2, 0x0807, 0
+// setB(uint24[]): 0x20, 11, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 -> 11, 0x00000a000009000008000007000006000005000004000003000002000001, 11
+// setB(uint24[]): 0x20, 10, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 -> 10, 0x00000a000009000008000007000006000005000004000003000002000001, 0
+// setC(int16[]): 0x20, 3, 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff, 2, 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd -> 0xfffd0002ffff, 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+// setD(bytes3[]): 0x20, 2, left(0x616263), left(0x646566) -> 0x646566616263, left(0x646566)
+// copyStatic() -> 1, 3, 0, 0
@@ -0,0 +1,39 @@
+contract C {
+    function freeMemoryPointer() internal pure returns (uint256 ptr) {
+        assembly { ptr := mload(0x40) }
+    }
+    function hashLoop(uint256 _n) public pure returns (bool, bool) {
+        uint256 start = freeMemoryPointer();
+        bytes32 h;
+        for (uint256 i = 0; i < _n; i++)
+            h = keccak256(abi.encodePacked(h, i));
+        bool released = freeMemoryPointer() == start;
+        bytes32 expectation;
+        for (uint256 i = 0; i < _n; i++) {
+            bytes memory data = abi.encodePacked(expectation, i);
+            expectation = keccak256(data);
+        }
+        return (released, h == expectation);
+    }
+    function reuse(uint256 _x) public pure returns (bool, bool, uint256, uint256) {
+        bytes memory a = abi.encode(_x);
+        uint256 start = freeMemoryPointer();
+        keccak256(abi.encodeWithSignature("f(uint256,uint256)", _x, _x));
+        // b occupies the memory that was used for hashing.
+        bytes memory b = abi.encode(_x + 1, _x + 2);
+        uint256 bStart;
+        assembly { bStart := b }
+        (uint256 y, uint256 z) = abi.decode(b, (uint256, uint256));
+        return (bStart == start, keccak256(a) == keccak256(abi.encodePacked(_x)), y, z);
+    }
+    function signature(uint256 _x) public pure returns (bool) {
+        bytes4 selector = bytes4(keccak256("f(uint256,uint256)"));
+        return
+            keccak256(abi.encodeWithSignature("f(uint256,uint256)", _x, _x)) ==
+            keccak256(abi.encodeWithSelector(selector, _x, _x));
+    }
+}
+// ----
+// hashLoop(uint256): 10 -> true, true
+// reuse(uint256): 7 -> true, true, 8, 9
+// signature(uint256): 7 -> true
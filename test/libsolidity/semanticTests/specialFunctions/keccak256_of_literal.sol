@@ -0,0 +1,22 @@
+contract C {
+    bytes32 constant LONG = keccak256("a string literal that is longer than thirty-two bytes");
+    function long() public pure returns (bool) {
+        bytes memory data = "a string literal that is longer than thirty-two bytes";
+        return LONG == keccak256(data);
+    }
+    function short() public pure returns (bool) {
+        bytes memory data = "abc";
+        return keccak256("abc") == keccak256(data);
+    }
+    function empty() public pure returns (bool) {
+        return keccak256("") == keccak256(new bytes(0));
+    }
+    function hexLiteral() public pure returns (bool) {
+        return keccak256(hex"00ff") == keccak256(abi.encodePacked(uint16(0xff)));
+    }
+}
+// ----
+// long() -> true
+// short() -> true
+// empty() -> true
+// hexLiteral() -> true
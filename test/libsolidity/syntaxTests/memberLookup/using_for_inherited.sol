@@ -0,0 +1,21 @@
+library L {
+    function twice(uint self) internal pure returns (uint) { return 2 * self; }
+    function last(uint[] storage self) internal view returns (uint) { return self[self.length - 1]; }
+}
+library M {
+    function twice(uint self, uint) internal pure returns (uint) { return 2 * self; }
+    function any(bytes32 self) internal pure returns (bytes32) { return self; }
+}
+contract A {
+    using L for uint;
+    using L for uint[];
+}
+contract B is A {
+    using L for uint;
+    using M for *;
+    uint[] values;
+    function f(uint x) public view returns (uint, uint, uint, bytes32) {
+        return (x.twice(), x.twice(1), values.last(), bytes32(x).any());
+    }
+}
+// ----
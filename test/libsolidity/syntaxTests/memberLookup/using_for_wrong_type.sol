@@ -0,0 +1,14 @@
+library L {
+    function last(uint[] storage self) internal view returns (uint) { return self[self.length - 1]; }
+}
+contract A {
+    using L for uint[];
+}
+contract B is A {
+    uint[2] fixedValues;
+    function f() public view returns (uint) {
+        return fixedValues.last();
+    }
+}
+// ----
+// TypeError: (259-275): Member "last" not found or not visible after argument-dependent lookup in uint256[2] storage ref.
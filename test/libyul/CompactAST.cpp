@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the index-based representation of the Yul AST.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/CompactAST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+/// @returns the IDs of the compact copies of all functions in @a _source.
+vector<CompactAST::NodeID> appendFunctions(CompactAST& _compact, Block const& _ast)
+{
+	vector<CompactAST::NodeID> functions;
+	for (auto const& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+			functions.push_back(_compact.append(statement));
+	return functions;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(YulCompactAST)
+
+BOOST_AUTO_TEST_CASE(equality)
+{
+	shared_ptr<Block> ast = parse(R"({
+		function f(a) -> b { let c := add(a, 0x01) switch c case 1 { b := 2 } case 2 { b := 3 } default { b := c } }
+		function g(x) -> y { let z := add(x, 1) switch z case 2 { y := 3 } case 0x1 { y := 2 } default { y := z } }
+		function h(x) -> y { let z := add(x, 2) switch z case 1 { y := 2 } case 2 { y := 3 } default { y := z } }
+		function i(x) -> y { let z := add(y, 1) switch z case 1 { y := 2 } case 2 { y := 3 } default { y := z } }
+		function j(x) -> y, w { let z := add(x, 1) switch z case 1 { y := 2 } case 2 { y := 3 } default { y := z } }
+	})", false).first;
+	CompactAST compact;
+	vector<CompactAST::NodeID> functions = appendFunctions(compact, *ast);
+	BOOST_REQUIRE_EQUAL(functions.size(), 5);
+	BOOST_CHECK(compact.equal(functions[0], functions[1]));
+	BOOST_CHECK_EQUAL(compact.hash(functions[0]), compact.hash(functions[1]));
+	for (size_t i = 2; i < functions.size(); ++i)
+	{
+		BOOST_CHECK(!compact.equal(functions[0], functions[i]));
+		BOOST_CHECK(compact.hash(functions[0]) != compact.hash(functions[i]));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
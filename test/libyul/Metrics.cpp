@@ -23,6 +23,8 @@
 #include <test/libyul/Common.h>
 
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AsmData.h>
 
 
@@ -44,6 +46,15 @@ size_t codeSize(string const& _source)
 	return CodeSize::codeSize(*ast);
 }
 
+dev::bigint gasCosts(string const& _expression, EVMVersion _evmVersion, bool _isCreation, size_t _runs)
+{
+	shared_ptr<Block> ast = parse("{ let x := " + _expression + " }", false).first;
+	BOOST_REQUIRE(ast);
+	shared_ptr<EVMDialect> dialect = EVMDialect::strictAssemblyForEVM(_evmVersion);
+	GasMeter meter(*dialect, _isCreation, _runs);
+	return meter.costs(*boost::get<VariableDeclaration>(ast->statements.front()).value);
+}
+
 }
 
 BOOST_AUTO_TEST_SUITE(YulCodeSize)
@@ -175,5 +186,44 @@ BOOST_AUTO_TEST_CASE(switch_statement_large)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(YulGasMeter)
+
+BOOST_AUTO_TEST_CASE(run_gas_depends_on_evm_version)
+{
+	// 50 or 200 for the SLOAD plus 3 for the PUSH, three bytes at 200 gas each.
+	BOOST_CHECK_EQUAL(gasCosts("sload(0)", EVMVersion::homestead(), false, 1), 53 + 600);
+	BOOST_CHECK_EQUAL(gasCosts("sload(0)", EVMVersion::constantinople(), false, 1), 203 + 600);
+}
+
+BOOST_AUTO_TEST_CASE(run_gas_is_multiplied_by_runs)
+{
+	BOOST_CHECK_EQUAL(gasCosts("calldatasize()", EVMVersion(), false, 1), 2 + 200);
+	BOOST_CHECK_EQUAL(gasCosts("calldatasize()", EVMVersion(), false, 200), 2 * 200 + 200);
+}
+
+BOOST_AUTO_TEST_CASE(creation_code_runs_once)
+{
+	BOOST_CHECK_EQUAL(gasCosts("calldatasize()", EVMVersion(), true, 200), 2 + 68);
+}
+
+BOOST_AUTO_TEST_CASE(literals_and_variables)
+{
+	BOOST_CHECK_EQUAL(gasCosts("0", EVMVersion(), false, 1), 3 + 2 * 200);
+	BOOST_CHECK_EQUAL(gasCosts("0x1234", EVMVersion(), false, 1), 3 + 3 * 200);
+	BOOST_CHECK_EQUAL(gasCosts("add(0, calldatasize())", EVMVersion(), false, 1), 3 + 2 + 3 + 4 * 200);
+}
+
+BOOST_AUTO_TEST_CASE(function_calls)
+{
+	shared_ptr<Block> ast = parse("{ function f(a) -> r {} let x := f(calldatasize()) }", false).first;
+	BOOST_REQUIRE(ast);
+	Expression const& call = *boost::get<VariableDeclaration>(ast->statements.back()).value;
+	shared_ptr<EVMDialect> dialect = EVMDialect::strictAssemblyForEVM(EVMVersion());
+	BOOST_CHECK_EQUAL(GasMeter(*dialect, false, 1).costs(call), 24 + 2 + 11 * 200);
+	BOOST_CHECK_EQUAL(GasMeter(*dialect, false, 10).costs(call), (24 + 2) * 10 + 11 * 200);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 }
 }
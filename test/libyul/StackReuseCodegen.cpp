@@ -72,7 +72,8 @@ BOOST_AUTO_TEST_CASE(single_var_assigned_plus_code)
 BOOST_AUTO_TEST_CASE(single_var_assigned_plus_code_and_reused)
 {
 	string out = assemble("{ let x := 1 mstore(3, 4) pop(mload(x)) }");
-	BOOST_CHECK_EQUAL(out, "PUSH1 0x1 PUSH1 0x4 PUSH1 0x3 MSTORE DUP1 MLOAD POP POP ");
+	// The last reference to x re-uses its stack slot.
+	BOOST_CHECK_EQUAL(out, "PUSH1 0x1 PUSH1 0x4 PUSH1 0x3 MSTORE MLOAD POP ");
 }
 
 BOOST_AUTO_TEST_CASE(multi_reuse_single_slot)
@@ -92,7 +93,7 @@ BOOST_AUTO_TEST_CASE(multi_reuse_same_variable_name)
 	string out = assemble("{ let z := mload(0) { let x := 1 x := 6 z := x } { let x := 2 z := x x := 4 } }");
 	BOOST_CHECK_EQUAL(out,
 		"PUSH1 0x0 MLOAD "
-		"PUSH1 0x1 PUSH1 0x6 SWAP1 POP DUP1 SWAP2 POP POP "
+		"PUSH1 0x1 PUSH1 0x6 SWAP1 POP SWAP1 POP "
 		"PUSH1 0x2 DUP1 SWAP2 POP PUSH1 0x4 SWAP1 POP POP "
 		"POP "
 	);
@@ -104,6 +105,26 @@ BOOST_AUTO_TEST_CASE(last_use_in_nested_block)
 	BOOST_CHECK_EQUAL(out, "PUSH1 0x0 DUP1 POP POP PUSH1 0x1 POP ");
 }
 
+BOOST_AUTO_TEST_CASE(last_use_reuses_slot)
+{
+	string out = assemble("{ let x := calldataload(0) let y := x sstore(1, y) }");
+	// y takes over the slot of x and the slot of y is used as the argument to sstore.
+	BOOST_CHECK_EQUAL(out, "PUSH1 0x0 CALLDATALOAD PUSH1 0x1 SSTORE ");
+}
+
+BOOST_AUTO_TEST_CASE(last_use_in_for_loop_condition)
+{
+	// The condition is evaluated repeatedly, so i cannot be removed there.
+	string out = assemble("{ for { let i := calldataload(0) } i {} { mstore(0, 0) } }");
+	BOOST_CHECK_EQUAL(out,
+		"PUSH1 0x0 CALLDATALOAD "
+		"JUMPDEST DUP1 ISZERO PUSH1 0x12 JUMPI "
+		"PUSH1 0x0 PUSH1 0x0 MSTORE "
+		"JUMPDEST PUSH1 0x3 JUMP "
+		"JUMPDEST POP "
+	);
+}
+
 BOOST_AUTO_TEST_CASE(if_)
 {
 	// z is only removed after the if (after the jumpdest)
@@ -338,8 +359,8 @@ BOOST_AUTO_TEST_CASE(reuse_slots_function_with_gaps)
 		// stack: d c x3 a b
 		"POP "
 		// stack: d c x3 a
-		"DUP1 DUP3 MSTORE "
-		"POP POP "
+		"DUP2 MSTORE " // the slot of a is re-used at its last reference
+		"POP "
 		// stack: d c
 		"DUP2 DUP2 MSTORE "
 		"POP POP "
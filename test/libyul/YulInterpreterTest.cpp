@@ -18,6 +18,7 @@
 #include <test/libyul/YulInterpreterTest.h>
 
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
 
 #include <test/Options.h>
 
@@ -72,7 +73,8 @@ bool YulInterpreterTest::run(ostream& _stream, string const& _linePrefix, bool c
 	if (!parse(_stream, _linePrefix, _formatted))
 		return false;
 
-	m_obtainedResult = interpret();
+	m_obtainedResult = interpret(false);
+	string compiledResult = interpret(true);
 
 	if (m_expectation != m_obtainedResult)
 	{
@@ -84,6 +86,13 @@ bool YulInterpreterTest::run(ostream& _stream, string const& _linePrefix, bool c
 		printIndented(_stream, m_obtainedResult, nextIndentLevel);
 		return false;
 	}
+	if (compiledResult != m_obtainedResult)
+	{
+		string nextIndentLevel = _linePrefix + "  ";
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Result of the compiled interpreter differs:" << endl;
+		printIndented(_stream, compiledResult, nextIndentLevel);
+		return false;
+	}
 	return true;
 }
 
@@ -126,31 +135,28 @@ bool YulInterpreterTest::parse(ostream& _stream, string const& _linePrefix, bool
 	}
 }
 
-string YulInterpreterTest::interpret()
+string YulInterpreterTest::interpret(bool _compiled)
 {
 	InterpreterState state;
 	state.maxTraceSize = 10000;
 	state.maxSteps = 10000;
 	state.maxMemSize = 0x20000000;
-	Interpreter interpreter(state);
 	try
 	{
-		interpreter(*m_ast);
+		if (_compiled)
+			CompiledInterpreter(*m_ast).run(state);
+		else
+		{
+			Interpreter interpreter(state);
+			interpreter(*m_ast);
+		}
 	}
 	catch (InterpreterTerminatedGeneric const&)
 	{
 	}
 
 	stringstream result;
-	result << "Trace:" << endl;;
-	for (auto const& line: interpreter.trace())
-		result << "  " << line << endl;
-	result << "Memory dump:\n";
-	for (size_t i = 0; i < state.memory.size(); i += 0x20)
-		result << "  " << std::hex << std::setw(4) << i << ": " << toHex(bytesConstRef(state.memory.data() + i, 0x20).toBytes()) << endl;
-	result << "Storage dump:" << endl;
-	for (auto const& slot: state.storage)
-		result << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
+	state.dumpTraceAndState(result);
 	return result.str();
 }
 
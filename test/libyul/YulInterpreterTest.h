@@ -56,7 +56,9 @@ public:
 private:
 	void printIndented(std::ostream& _stream, std::string const& _output, std::string const& _linePrefix = "") const;
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
-	std::string interpret();
+	/// Runs the code on the reference interpreter or the compiled interpreter and
+	/// @returns the trace and the final state.
+	std::string interpret(bool _compiled);
 
 	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
 
@@ -33,6 +33,8 @@
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -41,10 +43,12 @@
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
+#include <libyul/optimiser/RedundantStoreEliminator.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AsmAnalysis.h>
@@ -159,7 +163,10 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 	else if (m_optimizerStep == "expressionInliner")
 	{
 		disambiguate();
-		ExpressionInliner(*m_dialect, *m_ast).run();
+		unique_ptr<GasMeter> meter;
+		if (auto evmDialect = dynamic_pointer_cast<EVMDialect>(m_dialect))
+			meter = make_unique<GasMeter>(*evmDialect, false, 200);
+		ExpressionInliner(*m_dialect, *m_ast, meter.get()).run();
 	}
 	else if (m_optimizerStep == "fullInliner")
 	{
@@ -200,6 +207,19 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		ExpressionJoiner::run(*m_ast);
 		ExpressionJoiner::run(*m_ast);
 	}
+	else if (m_optimizerStep == "loadResolver")
+	{
+		disambiguate();
+		NameDispenser nameDispenser{*m_dialect, *m_ast};
+		ExpressionSplitter{*m_dialect, nameDispenser}(*m_ast);
+		ForLoopInitRewriter{}(*m_ast);
+		CommonSubexpressionEliminator{*m_dialect}(*m_ast);
+		ExpressionSimplifier::run(*m_dialect, *m_ast);
+		LoadResolver::run(*m_dialect, *m_ast);
+		UnusedPruner::runUntilStabilised(*m_dialect, *m_ast);
+		ExpressionJoiner::run(*m_ast);
+		ExpressionJoiner::run(*m_ast);
+	}
 	else if (m_optimizerStep == "unusedPruner")
 	{
 		disambiguate();
@@ -222,6 +242,18 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		disambiguate();
 		RedundantAssignEliminator::run(*m_dialect, *m_ast);
 	}
+	else if (m_optimizerStep == "loopInvariantCodeMotion")
+	{
+		disambiguate();
+		ForLoopInitRewriter{}(*m_ast);
+		LoopInvariantCodeMotion::run(*m_dialect, *m_ast);
+	}
+	else if (m_optimizerStep == "redundantStoreEliminator")
+	{
+		disambiguate();
+		ForLoopInitRewriter{}(*m_ast);
+		RedundantStoreEliminator::run(*m_dialect, *m_ast);
+	}
 	else if (m_optimizerStep == "ssaPlusCleanup")
 	{
 		disambiguate();
@@ -265,7 +297,12 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		(BlockFlattener{})(*m_ast);
 	}
 	else if (m_optimizerStep == "fullSuite")
-		OptimiserSuite::run(m_dialect, *m_ast, *m_analysisInfo, true);
+	{
+		unique_ptr<GasMeter> meter;
+		if (auto evmDialect = dynamic_pointer_cast<EVMDialect>(m_dialect))
+			meter = make_unique<GasMeter>(*evmDialect, false, 200);
+		OptimiserSuite::run(m_dialect, meter.get(), *m_ast, *m_analysisInfo, true);
+	}
 	else
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Invalid optimizer step: " << m_optimizerStep << endl;
@@ -59,7 +59,10 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "Path to editor for opening test files.")
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
-		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
+		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.")
+		("jobs,j", po::value<unsigned>(&jobs)->default_value(1), "Number of processes running the test cases in parallel. Failures are handled interactively afterwards, in order.")
+		("shard", po::value<std::string>(&m_shard), "Only run the i-th of n parts of the test cases of each suite, given as i/n with 0 <= i < n.")
+		("slowest", po::value<unsigned>(&slowest)->default_value(0), "List the given number of slowest test cases with their run time at the end.");
 }
 
 bool IsolTestOptions::parse(int _argc, char const* const* _argv)
@@ -72,6 +75,18 @@ bool IsolTestOptions::parse(int _argc, char const* const* _argv)
 		return false;
 	}
 
+	if (!m_shard.empty())
+	{
+		std::smatch match;
+		assertThrow(
+			std::regex_match(m_shard, match, std::regex{"([0-9]+)/([0-9]+)"}),
+			ConfigException,
+			"Invalid shard, expected i/n: " + m_shard
+		);
+		shardIndex = unsigned(std::stoul(match[1]));
+		shardCount = unsigned(std::stoul(match[2]));
+	}
+
 	return res;
 }
 
@@ -84,6 +99,11 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(shardIndex < shardCount, ConfigException, "Invalid shard, expected i/n with 0 <= i < n.");
+	assertThrow(jobs >= 1, ConfigException, "The number of jobs has to be positive.");
+#if defined(_WIN32)
+	assertThrow(jobs == 1, ConfigException, "Running test cases in parallel is not supported on Windows.");
+#endif
 }
 
 }
@@ -33,10 +33,20 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	std::string testFilter = std::string{};
+	/// Number of processes that run the test cases in parallel.
+	unsigned jobs = 1;
+	/// Only the test cases with an index congruent to shardIndex modulo shardCount are run.
+	unsigned shardIndex = 0;
+	unsigned shardCount = 1;
+	/// Number of slowest test cases to list at the end.
+	unsigned slowest = 0;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
 	void validate() const override;
+
+private:
+	std::string m_shard;
 };
 }
 }
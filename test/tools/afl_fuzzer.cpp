@@ -38,6 +38,7 @@ int main(int argc, char** argv)
 		R"(solfuzzer, fuzz-testing binary for use with AFL.
 Usage: solfuzzer [Options] < input
 Reads a single source from stdin, compiles it and signals a failure for internal errors.
+If compiled with afl-clang-fast, reads one input after the other in persistent mode.
 
 Allowed options)",
 		po::options_description::m_default_line_length,
@@ -108,6 +109,31 @@ Allowed options)",
 	bool optimize = !arguments.count("without-optimizer");
 	int retResult = 0;
 
+	auto runInput = [&](string const& _input)
+	{
+		if (arguments.count("const-opt"))
+			FuzzerUtil::testConstantOptimizer(_input, quiet);
+		else if (arguments.count("standard-json"))
+			FuzzerUtil::testStandardCompiler(_input, quiet);
+		else
+			FuzzerUtil::testCompiler(_input, optimize, quiet);
+		FuzzerUtil::resetGlobalState();
+	};
+
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+	// Persistent mode of afl-clang-fast: The process is re-used for many inputs,
+	// which are provided on standard input, one after the other.
+	if (inputs == vector<string>{""})
+	{
+		while (__AFL_LOOP(1000))
+		{
+			runInput(readStandardInput());
+			cin.clear();
+		}
+		return 0;
+	}
+#endif
+
 	for (string const& inputFile: inputs)
 	{
 		string input;
@@ -118,12 +144,7 @@ Allowed options)",
 
 		try
 		{
-			if (arguments.count("const-opt"))
-				FuzzerUtil::testConstantOptimizer(input, quiet);
-			else if (arguments.count("standard-json"))
-				FuzzerUtil::testStandardCompiler(input, quiet);
-			else
-				FuzzerUtil::testCompiler(input, optimize, quiet);
+			runInput(input);
 		}
 		catch (...)
 		{
@@ -21,6 +21,8 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libsolc/libsolc.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libyul/YulString.h>
 
 #include <sstream>
 
@@ -129,3 +131,9 @@ void FuzzerUtil::testStandardCompiler(string const& _input, bool _quiet)
 
 	runCompiler(_input, _quiet);
 }
+
+void FuzzerUtil::resetGlobalState()
+{
+	dev::solidity::TypeProvider::reset();
+	yul::YulStringRepository::instance().reset();
+}
@@ -27,4 +27,7 @@ struct FuzzerUtil
 	static void testCompiler(std::string const& _input, bool _optimize, bool _quiet);
 	static void testConstantOptimizer(std::string const& _input, bool _quiet);
 	static void testStandardCompiler(std::string const& _input, bool _quiet);
+	/// Resets the global state of the compiler that would otherwise accumulate
+	/// over the inputs of a long-running fuzzer process.
+	static void resetGlobalState();
 };
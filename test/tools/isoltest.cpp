@@ -26,16 +26,24 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <fstream>
-#include <queue>
 #include <regex>
+#include <sstream>
 
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace dev;
@@ -54,12 +62,15 @@ struct TestStats
 	int successCount = 0;
 	int testCount = 0;
 	int skippedCount = 0;
+	/// Run times of the test cases in milliseconds, together with their names.
+	vector<pair<double, string>> runTimes;
 	operator bool() const noexcept { return successCount + skippedCount == testCount; }
-	TestStats& operator+=(TestStats const& _other) noexcept
+	TestStats& operator+=(TestStats const& _other)
 	{
 		successCount += _other.successCount;
 		testCount += _other.testCount;
 		skippedCount += _other.skippedCount;
+		runTimes.insert(runTimes.end(), _other.runTimes.begin(), _other.runTimes.end());
 		return *this;
 	}
 };
@@ -87,6 +98,16 @@ private:
 	regex m_filterExpression;
 };
 
+namespace
+{
+
+double millisecondsSince(chrono::steady_clock::time_point _start)
+{
+	return double(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - _start).count()) / 1000;
+}
+
+}
+
 class TestTool
 {
 public:
@@ -98,7 +119,6 @@ public:
 	):
 		m_testCaseCreator(_testCaseCreator),
 		m_options(_options),
-		m_filter(TestFilter{_options.testFilter}),
 		m_path(_path),
 		m_name(_name)
 	{}
@@ -111,13 +131,17 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case and prints the result to @a _stream.
+	Result process(ostream& _stream);
 
+	/// Runs the test cases below @a _path. If @a _parallel is true, they are run
+	/// in @a _options.jobs processes and failures are handled interactively afterwards.
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
 		TestOptions const& _options,
 		fs::path const& _basepath,
-		fs::path const& _path
+		fs::path const& _path,
+		bool _parallel
 	);
 
 	static string editor;
@@ -131,9 +155,20 @@ private:
 
 	Request handleResponse(bool _exception);
 
+	/// @returns the test files below @a _path, relative to @a _basepath, in a deterministic order.
+	static vector<fs::path> collectTests(fs::path const& _basepath, fs::path const& _path);
+
+	/// Runs a test case and lets the user handle a failure, updating @a _stats.
+	static void processInteractively(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		fs::path const& _path,
+		TestStats& _stats
+	);
+
 	TestCreator m_testCaseCreator;
 	TestOptions const& m_options;
-	TestFilter m_filter;
 	fs::path const m_path;
 	string const m_name;
 
@@ -145,7 +180,7 @@ private:
 string TestTool::editor;
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool success;
 	bool formatted{!m_options.noColor};
@@ -153,55 +188,50 @@ TestTool::Result TestTool::process()
 
 	try
 	{
-		if (m_filter.matches(m_name))
-		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+		(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
-			m_test = m_testCaseCreator(TestCase::Config{m_path.string(), m_options.ipcPath.string(), m_options.evmVersion()});
-			if (m_test->validateSettings(m_options.evmVersion()))
-				success = m_test->run(outputMessages, "  ", formatted);
-			else
-			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
-				return Result::Skipped;
-			}
-		}
+		m_test = m_testCaseCreator(TestCase::Config{m_path.string(), m_options.ipcPath.string(), m_options.evmVersion()});
+		if (m_test->validateSettings(m_options.evmVersion()))
+			success = m_test->run(outputMessages, "  ", formatted);
 		else
+		{
+			AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 			return Result::Skipped;
+		}
 	}
 	catch(boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << _e.what() << endl;
 		return Result::Exception;
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
 
 	if (success)
 	{
-		AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+		AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << endl;
 		return Result::Success;
 	}
 	else
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+		AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-		AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-		m_test->printSource(cout, "    ", formatted);
-		m_test->printUpdatedSettings(cout, "    ", formatted);
+		AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+		m_test->printSource(_stream, "    ", formatted);
+		m_test->printUpdatedSettings(_stream, "    ", formatted);
 
-		cout << endl << outputMessages.str() << endl;
+		_stream << endl << outputMessages.str() << endl;
 		return Result::Failure;
 	}
 }
@@ -248,84 +278,306 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
+namespace
+{
+
+/// The outcome of a test case run in a worker process.
+struct TestOutcome
+{
+	TestTool::Result result;
+	string output;
+	double milliseconds;
+};
+
+/**
+ * Runs test cases in worker processes. Processes are used instead of threads, since
+ * the global state of the compiler, e.g. the type provider, is not thread-safe.
+ * Test case i is run by worker i modulo the number of workers and the outcomes
+ * are retrieved in order of the test cases.
+ */
+class ParallelTestRunner
+{
+public:
+	ParallelTestRunner(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		vector<fs::path> const& _tests
+	);
+	~ParallelTestRunner();
+
+	/// @returns the outcome of test case @a _index, which has to be larger than that of
+	/// the previous call, or nothing if its worker terminated unexpectedly.
+	boost::optional<TestOutcome> outcome(size_t _index);
+
+private:
+	struct Header
+	{
+		uint64_t index;
+		int32_t result;
+		double milliseconds;
+		uint64_t outputSize;
+	};
+
+	static bool writeAll(int _fd, char const* _data, size_t _size);
+	static bool readAll(int _fd, char* _data, size_t _size);
+
+	vector<int> m_pipes;
+	vector<pid_t> m_workers;
+};
+
+ParallelTestRunner::ParallelTestRunner(
 	TestCreator _testCaseCreator,
 	TestOptions const& _options,
 	fs::path const& _basepath,
-	fs::path const& _path
+	vector<fs::path> const& _tests
 )
 {
-	std::queue<fs::path> paths;
-	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
-
-	while (!paths.empty())
+#if !defined(_WIN32)
+	size_t jobs = min<size_t>(_options.jobs, _tests.size());
+	// Buffered output would otherwise be written by every worker.
+	cout.flush();
+	cerr.flush();
+	for (size_t job = 0; job < jobs; ++job)
 	{
-		auto currentPath = paths.front();
-
-		fs::path fullpath = _basepath / currentPath;
-		if (fs::is_directory(fullpath))
+		int fds[2];
+		if (pipe(fds) != 0)
+			break;
+		pid_t pid = fork();
+		if (pid < 0)
 		{
-			paths.pop();
-			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
-				fs::directory_iterator(fullpath),
-				fs::directory_iterator()
-			))
-				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
-					paths.push(currentPath / entry.path().filename());
+			close(fds[0]);
+			close(fds[1]);
+			break;
 		}
-		else if (m_exitRequested)
+		if (pid == 0)
 		{
-			++testCount;
-			paths.pop();
+			close(fds[0]);
+			for (int fd: m_pipes)
+				close(fd);
+			for (size_t i = job; i < _tests.size(); i += jobs)
+			{
+				TestTool testTool(_testCaseCreator, _options, _basepath / _tests[i], _tests[i].string());
+				ostringstream output;
+				auto start = chrono::steady_clock::now();
+				TestTool::Result result = testTool.process(output);
+				string text = output.str();
+				Header header{i, int32_t(result), millisecondsSince(start), text.size()};
+				if (
+					!writeAll(fds[1], reinterpret_cast<char const*>(&header), sizeof(header)) ||
+					!writeAll(fds[1], text.data(), text.size())
+				)
+					break;
+			}
+			close(fds[1]);
+			_exit(0);
 		}
-		else
+		close(fds[1]);
+		m_pipes.push_back(fds[0]);
+		m_workers.push_back(pid);
+	}
+#else
+	(void)_testCaseCreator;
+	(void)_options;
+	(void)_basepath;
+	(void)_tests;
+#endif
+}
+
+ParallelTestRunner::~ParallelTestRunner()
+{
+#if !defined(_WIN32)
+	// Closing the pipes lets workers that are not done yet terminate when they write.
+	for (int fd: m_pipes)
+		close(fd);
+	for (pid_t pid: m_workers)
+		waitpid(pid, nullptr, 0);
+#endif
+}
+
+boost::optional<TestOutcome> ParallelTestRunner::outcome(size_t _index)
+{
+	if (m_pipes.empty())
+		return {};
+	int fd = m_pipes[_index % m_pipes.size()];
+	if (fd < 0)
+		return {};
+
+	Header header;
+	TestOutcome outcome;
+	bool success = readAll(fd, reinterpret_cast<char*>(&header), sizeof(header)) && header.index == _index;
+	if (success)
+	{
+		outcome.result = TestTool::Result(header.result);
+		outcome.milliseconds = header.milliseconds;
+		outcome.output.resize(header.outputSize);
+		success = readAll(fd, &outcome.output[0], outcome.output.size());
+	}
+	if (!success)
+	{
+		close(fd);
+		m_pipes[_index % m_pipes.size()] = -1;
+		return {};
+	}
+	return outcome;
+}
+
+bool ParallelTestRunner::writeAll(int _fd, char const* _data, size_t _size)
+{
+#if !defined(_WIN32)
+	while (_size > 0)
+	{
+		ssize_t written = write(_fd, _data, _size);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return false;
+		_data += written;
+		_size -= size_t(written);
+	}
+	return true;
+#else
+	(void)_fd;
+	(void)_data;
+	return _size == 0;
+#endif
+}
+
+bool ParallelTestRunner::readAll(int _fd, char* _data, size_t _size)
+{
+#if !defined(_WIN32)
+	while (_size > 0)
+	{
+		ssize_t bytesRead = read(_fd, _data, _size);
+		if (bytesRead < 0 && errno == EINTR)
+			continue;
+		if (bytesRead <= 0)
+			return false;
+		_data += bytesRead;
+		_size -= size_t(bytesRead);
+	}
+	return true;
+#else
+	(void)_fd;
+	(void)_data;
+	return _size == 0;
+#endif
+}
+
+}
+
+vector<fs::path> TestTool::collectTests(fs::path const& _basepath, fs::path const& _path)
+{
+	vector<fs::path> tests;
+	fs::path fullpath = _basepath / _path;
+	if (!fs::is_directory(fullpath))
+		return {_path};
+	for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
+		fs::directory_iterator(fullpath),
+		fs::directory_iterator()
+	))
+		if (fs::is_directory(entry.path()))
+			for (auto&& test: collectTests(_basepath, _path / entry.path().filename()))
+				tests.emplace_back(move(test));
+		else if (TestCase::isTestFilename(entry.path().filename()))
+			tests.emplace_back(_path / entry.path().filename());
+	sort(tests.begin(), tests.end());
+	return tests;
+}
+
+void TestTool::processInteractively(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	TestStats& _stats
+)
+{
+	while (true)
+	{
+		++_stats.testCount;
+		TestTool testTool(_testCaseCreator, _options, _basepath / _path, _path.string());
+		auto start = chrono::steady_clock::now();
+		auto result = testTool.process(cout);
+		_stats.runTimes.emplace_back(millisecondsSince(start), _path.string());
+
+		switch(result)
 		{
-			++testCount;
-			TestTool testTool(
-				_testCaseCreator,
-				_options,
-				fullpath,
-				currentPath.string()
-			);
-			auto result = testTool.process();
-
-			switch(result)
+		case Result::Failure:
+		case Result::Exception:
+			switch(testTool.handleResponse(result == Result::Exception))
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
-				{
-				case Request::Quit:
-					paths.pop();
-					m_exitRequested = true;
-					break;
-				case Request::Rerun:
-					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
-				case Request::Skip:
-					paths.pop();
-					++skippedCount;
-					break;
-				}
-				break;
-			case Result::Success:
-				paths.pop();
-				++successCount;
-				break;
-			case Result::Skipped:
-				paths.pop();
-				++skippedCount;
-				break;
+			case Request::Quit:
+				m_exitRequested = true;
+				return;
+			case Request::Rerun:
+				cout << "Re-running test case..." << endl;
+				--_stats.testCount;
+				_stats.runTimes.pop_back();
+				continue;
+			case Request::Skip:
+				++_stats.skippedCount;
+				return;
 			}
+			break;
+		case Result::Success:
+			++_stats.successCount;
+			return;
+		case Result::Skipped:
+			++_stats.skippedCount;
+			return;
 		}
 	}
+}
 
-	return { successCount, testCount, skippedCount };
+TestStats TestTool::processPath(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	bool _parallel
+)
+{
+	TestStats stats;
+	TestFilter filter{_options.testFilter};
+	vector<fs::path> tests;
+	size_t matchingCount = 0;
+	for (auto const& test: collectTests(_basepath, _path))
+		if (!filter.matches(test.string()))
+		{
+			++stats.testCount;
+			++stats.skippedCount;
+		}
+		else if (matchingCount++ % _options.shardCount == _options.shardIndex)
+			tests.push_back(test);
+
+	unique_ptr<ParallelTestRunner> runner;
+	if (_parallel && _options.jobs > 1 && tests.size() > 1 && !m_exitRequested)
+		runner = make_unique<ParallelTestRunner>(_testCaseCreator, _options, _basepath, tests);
+
+	for (size_t i = 0; i < tests.size(); ++i)
+	{
+		if (m_exitRequested)
+		{
+			++stats.testCount;
+			continue;
+		}
+		boost::optional<TestOutcome> outcome;
+		if (runner)
+			outcome = runner->outcome(i);
+		if (outcome && (outcome->result == Result::Success || outcome->result == Result::Skipped))
+		{
+			cout << outcome->output;
+			++stats.testCount;
+			++(outcome->result == Result::Success ? stats.successCount : stats.skippedCount);
+			stats.runTimes.emplace_back(outcome->milliseconds, tests[i].string());
+		}
+		else
+			// Failures are run again here, since handling them requires interaction.
+			processInteractively(_testCaseCreator, _options, _basepath, tests[i], stats);
+	}
 
+	return stats;
 }
 
 namespace
@@ -356,7 +608,8 @@ boost::optional<TestStats> runTestSuite(
 	TestOptions const& _options,
 	fs::path const& _basePath,
 	fs::path const& _subdirectory,
-	string const& _name
+	string const& _name,
+	bool _parallel
 )
 {
 	fs::path testPath{_basePath / _subdirectory};
@@ -372,7 +625,8 @@ boost::optional<TestStats> runTestSuite(
 		_testCaseCreator,
 		_options,
 		_basePath,
-		_subdirectory
+		_subdirectory,
+		_parallel
 	);
 
 	if (stats.skippedCount != stats.testCount)
@@ -415,7 +669,7 @@ int main(int argc, char const *argv[])
 		return 1;
 	}
 
-	TestStats global_stats{0, 0};
+	TestStats global_stats;
 	cout << "Running tests..." << endl << endl;
 
 	// Actually run the tests.
@@ -433,7 +687,9 @@ int main(int argc, char const *argv[])
 			options,
 			options.testPath / ts.path,
 			ts.subpath,
-			ts.title
+			ts.title,
+			// Tests using IPC share the node, so they cannot run in parallel.
+			!ts.ipc
 		);
 		if (stats)
 			global_stats += *stats;
@@ -453,5 +709,15 @@ int main(int argc, char const *argv[])
 	}
 	cout << "." << endl;
 
+	if (options.slowest > 0 && !global_stats.runTimes.empty())
+	{
+		auto& runTimes = global_stats.runTimes;
+		size_t count = min<size_t>(options.slowest, runTimes.size());
+		partial_sort(runTimes.begin(), runTimes.begin() + count, runTimes.end(), greater<pair<double, string>>());
+		cout << endl << "Slowest tests:" << endl;
+		for (size_t i = 0; i < count; ++i)
+			cout << fixed << setprecision(1) << setw(10) << runTimes[i].first << " ms  " << runTimes[i].second << endl;
+	}
+
 	return global_stats ? 0 : 1;
 }
@@ -25,6 +25,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	{
 		string input(reinterpret_cast<char const*>(_data), _size);
 		FuzzerUtil::testCompiler(input, /*optimize=*/false, /*quiet=*/true);
+		FuzzerUtil::resetGlobalState();
 	}
 	return 0;
 }
@@ -16,6 +16,7 @@
 */
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/YulString.h>
 #include <liblangutil/EVMVersion.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
 
@@ -27,6 +28,9 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	if (_size > 600)
 		return 0;
 
+	// None of the identifiers of previous inputs is used anymore.
+	YulStringRepository::instance().reset();
+
 	string input(reinterpret_cast<char const*>(_data), _size);
 	AssemblyStack stack(
 		langutil::EVMVersion(),
@@ -21,6 +21,7 @@
 #include <libyul/Dialect.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/YulString.h>
 
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/ErrorReporter.h>
@@ -48,6 +49,9 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	if (_size > 600)
 		return 0;
 
+	// None of the identifiers of previous inputs is used anymore.
+	YulStringRepository::instance().reset();
+
 	string input(reinterpret_cast<char const*>(_data), _size);
 
 	if (std::any_of(input.begin(), input.end(), [](char c) {
@@ -74,12 +78,12 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 		return 0;
 	}
 
-	ostringstream os1;
-	ostringstream os2;
+	yul::test::InterpreterState state1;
+	yul::test::InterpreterState state2;
 	try
 	{
 		yulFuzzerUtil::interpret(
-			os1,
+			state1,
 			stack.parserResult()->code
 		);
 	}
@@ -95,7 +99,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	try
 	{
 		yulFuzzerUtil::interpret(
-			os2,
+			state2,
 			stack.parserResult()->code,
 			(yul::test::yul_fuzzer::yulFuzzerUtil::maxSteps * 1.5)
 		);
@@ -104,7 +108,9 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	{
 	}
 
-	bool isTraceEq = (os1.str() == os2.str());
-	yulAssert(isTraceEq, "Interpreted traces for optimized and unoptimized code differ.");
+	yulAssert(
+		yulFuzzerUtil::sameEffects(state1, state2),
+		"Interpreted traces or storage for optimized and unoptimized code differ."
+	);
 	return 0;
 }
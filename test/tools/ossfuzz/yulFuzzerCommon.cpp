@@ -17,24 +17,47 @@
 #include <test/tools/ossfuzz/yulFuzzerCommon.h>
 
 using namespace std;
+using namespace dev;
 using namespace yul;
 using namespace yul::test::yul_fuzzer;
 
 void yulFuzzerUtil::interpret(
-	ostream& _os,
+	InterpreterState& _state,
 	shared_ptr<yul::Block> _ast,
 	size_t _maxSteps,
 	size_t _maxTraceSize,
 	size_t _maxMemory
 )
 {
-	InterpreterState state;
-	state.maxTraceSize = _maxTraceSize;
-	state.maxSteps = _maxSteps;
-	state.maxMemSize = _maxMemory;
-	Interpreter interpreter(state);
-	interpreter(*_ast);
-	_os << "Trace:" << endl;
-	for (auto const& line: interpreter.trace())
-		_os << "  " << line << endl;
+	_state.maxTraceSize = _maxTraceSize;
+	_state.maxSteps = _maxSteps;
+	_state.maxMemSize = _maxMemory;
+	_state.traceReads = false;
+	_state.traceWrites = false;
+	CompiledInterpreter(*_ast).run(_state);
+}
+
+bool yulFuzzerUtil::sameEffects(InterpreterState const& _state1, InterpreterState const& _state2)
+{
+	if (_state1.trace.hash() != _state2.trace.hash())
+		return false;
+
+	InterpreterTrace const& trace = _state1.trace;
+	if (
+		trace.endsWith(eth::Instruction::REVERT) ||
+		trace.endsWith(eth::Instruction::INVALID) ||
+		trace.endsWith(InterpreterTrace::PseudoOperation::TraceLimitReached) ||
+		trace.endsWith(InterpreterTrace::PseudoOperation::StepLimitReached)
+	)
+		return true;
+
+	// Loads insert zero-valued slots into the storage, they are not compared.
+	auto nonZeroSlots = [](InterpreterState const& _state) {
+		map<h256, h256> slots;
+		for (auto const& slot: _state.storage)
+			if (slot.second != h256())
+				slots.insert(slot);
+		return slots;
+	};
+	return nonZeroSlots(_state1) == nonZeroSlots(_state2);
 }
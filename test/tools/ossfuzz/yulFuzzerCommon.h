@@ -14,7 +14,7 @@
 	You should have received a copy of the GNU General Public License
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
-#include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
 
 namespace yul
 {
@@ -24,13 +24,22 @@ namespace yul_fuzzer
 {
 struct yulFuzzerUtil
 {
+	/// Runs the code on @a _state with the given limits. The trace of the
+	/// execution is recorded in the state even if an exception is thrown.
+	/// Reads from and writes to storage and memory are not traced, so that the
+	/// traces of optimised and unoptimised code can be compared.
 	static void interpret(
-		std::ostream& _os,
+		InterpreterState& _state,
 		std::shared_ptr<yul::Block> _ast,
 		size_t _maxSteps = maxSteps,
 		size_t _maxTraceSize = maxTraceSize,
 		size_t _maxMemory = maxMemory
 	);
+	/// @returns true if the executions that resulted in @a _state1 and @a _state2 have
+	/// the same effects: The same trace and, unless the changes to the storage are
+	/// discarded or an execution was stopped by a limit, the same storage.
+	/// Removed loads and dead stores do not change the effects.
+	static bool sameEffects(InterpreterState const& _state1, InterpreterState const& _state2);
 	static size_t constexpr maxSteps = 100;
 	static size_t constexpr maxTraceSize = 75;
 	static size_t constexpr maxMemory = 0x200;
@@ -23,6 +23,7 @@
 #include <src/libfuzzer/libfuzzer_macro.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/YulString.h>
 #include <liblangutil/EVMVersion.h>
 #include <libyul/Exceptions.h>
 
@@ -32,6 +33,9 @@ using namespace std;
 
 DEFINE_PROTO_FUZZER(Function const& _input)
 {
+	// None of the identifiers of previous inputs is used anymore.
+	YulStringRepository::instance().reset();
+
 	ProtoConverter converter;
 	string yul_source = converter.functionToString(_input);
 	if (yul_source.size() > 600)
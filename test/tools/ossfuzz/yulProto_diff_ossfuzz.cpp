@@ -23,6 +23,7 @@
 #include <src/libfuzzer/libfuzzer_macro.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/YulString.h>
 #include <liblangutil/EVMVersion.h>
 #include <libyul/Exceptions.h>
 
@@ -38,6 +39,9 @@ using namespace yul::test;
 
 DEFINE_PROTO_FUZZER(Function const& _input)
 {
+	// None of the identifiers of previous inputs is used anymore.
+	YulStringRepository::instance().reset();
+
 	ProtoConverter converter;
 	string yul_source = converter.functionToString(_input);
 	if (yul_source.size() > 600)
@@ -70,12 +74,12 @@ DEFINE_PROTO_FUZZER(Function const& _input)
 		return;
 	}
 
-	ostringstream os1;
-	ostringstream os2;
+	InterpreterState state1;
+	InterpreterState state2;
 	try
 	{
 		yulFuzzerUtil::interpret(
-			os1,
+			state1,
 			stack.parserResult()->code
 		);
 	}
@@ -90,7 +94,7 @@ DEFINE_PROTO_FUZZER(Function const& _input)
 	stack.optimize();
 	try
 	{
-		yulFuzzerUtil::interpret(os2,
+		yulFuzzerUtil::interpret(state2,
 			stack.parserResult()->code,
 			(yul::test::yul_fuzzer::yulFuzzerUtil::maxSteps * 1.5)
 		);
@@ -99,7 +103,9 @@ DEFINE_PROTO_FUZZER(Function const& _input)
 	{
 	}
 
-	bool isTraceEq = (os1.str() == os2.str());
-	yulAssert(isTraceEq, "Interpreted traces for optimized and unoptimized code differ.");
+	yulAssert(
+		yulFuzzerUtil::sameEffects(state1, state2),
+		"Interpreted traces or storage for optimized and unoptimized code differ."
+	);
 	return;
 }
@@ -0,0 +1,664 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmarks of the compiler itself, with machine-readable results
+ * and an optional comparison against a previous run.
+ */
+
+#include <test/tools/fuzzer_common.h>
+#include <test/tools/ossfuzz/yulFuzzerCommon.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <libyul/AssemblyStack.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace langutil;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// A set of Solidity sources that are compiled together.
+struct Project
+{
+	string name;
+	StringMap sources;
+
+	size_t size() const
+	{
+		size_t size = 0;
+		for (auto const& source: sources)
+			size += source.second.size();
+		return size;
+	}
+};
+
+struct YulSource
+{
+	string name;
+	string source;
+};
+
+class BenchmarkRunner
+{
+public:
+	BenchmarkRunner(unsigned _repetitions, string _filter):
+		m_repetitions(_repetitions), m_filter(move(_filter))
+	{}
+
+	/// Runs @a _body once as warm-up and then @a m_repetitions times.
+	/// @a _body returns the time in microseconds that should be attributed to the benchmark
+	/// or a negative value if the wall-clock time of the whole call is to be used.
+	/// If @a _executions is non-zero, the throughput in executions per second is reported as well.
+	void run(string const& _name, size_t _inputBytes, function<double()> const& _body, size_t _executions = 0)
+	{
+		if (!m_filter.empty() && _name.find(m_filter) == string::npos)
+			return;
+		cerr << _name << "..." << flush;
+
+		vector<double> times;
+		for (unsigned i = 0; i <= m_repetitions; ++i)
+		{
+			auto start = chrono::steady_clock::now();
+			double time = _body();
+			if (time < 0)
+				time = double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / 1000;
+			if (i > 0)
+				times.push_back(time);
+		}
+		sort(times.begin(), times.end());
+
+		Json::Value result(Json::objectValue);
+		result["name"] = _name;
+		result["repetitions"] = m_repetitions;
+		result["inputBytes"] = Json::UInt64(_inputBytes);
+		result["minMicroseconds"] = times.front();
+		result["medianMicroseconds"] = times[times.size() / 2];
+		result["maxMicroseconds"] = times.back();
+		double executionsPerSecond = _executions * 1e6 / max(times[times.size() / 2], 1e-3);
+		if (_executions > 0)
+			result["executionsPerSecond"] = executionsPerSecond;
+		m_results.append(result);
+
+		cerr << " " << (boost::format("%.3f") % (times[times.size() / 2] / 1000)) << " ms";
+		if (_executions > 0)
+			cerr << " (" << (boost::format("%.1f") % executionsPerSecond) << " execs/s)";
+		cerr << endl;
+	}
+
+	Json::Value const& results() const { return m_results; }
+
+private:
+	unsigned m_repetitions;
+	string m_filter;
+	Json::Value m_results{Json::arrayValue};
+};
+
+void printErrors(ErrorList const& _errors, string const& _context)
+{
+	cerr << _context << endl;
+	SourceReferenceFormatter formatter(cerr);
+	for (auto const& error: _errors)
+		formatter.printErrorInformation(*error);
+}
+
+bool hasErrors(ErrorList const& _errors)
+{
+	for (auto const& error: _errors)
+		if (error->type() != Error::Type::Warning)
+			return true;
+	return false;
+}
+
+/// @returns the sum of the times of all phases called @a _name in the profile.
+double phaseTime(Json::Value const& _phases, string const& _name)
+{
+	double time = 0;
+	for (auto const& phase: _phases)
+		if (phase["name"].asString() == _name)
+			time += phase["microseconds"].asDouble();
+		else
+			time += phaseTime(phase["phases"], _name);
+	return time;
+}
+
+vector<Project> loadProjects(fs::path const& _directory)
+{
+	vector<Project> projects;
+	if (!fs::is_directory(_directory))
+		return projects;
+	for (fs::directory_iterator it(_directory); it != fs::directory_iterator(); ++it)
+	{
+		if (!fs::is_directory(it->path()))
+			continue;
+		Project project;
+		project.name = it->path().filename().string();
+		for (fs::recursive_directory_iterator file(it->path()); file != fs::recursive_directory_iterator(); ++file)
+			if (fs::is_regular_file(file->path()) && file->path().extension() == ".sol")
+			{
+				// Source names are relative to the project so that relative imports resolve.
+				string name = file->path().string().substr(it->path().string().size() + 1);
+				project.sources[name] = readFileAsString(file->path().string());
+			}
+		if (!project.sources.empty())
+			projects.emplace_back(move(project));
+	}
+	sort(projects.begin(), projects.end(), [](Project const& _a, Project const& _b) { return _a.name < _b.name; });
+	return projects;
+}
+
+vector<YulSource> loadYulSources(fs::path const& _directory)
+{
+	vector<YulSource> sources;
+	if (!fs::is_directory(_directory))
+		return sources;
+	for (fs::directory_iterator it(_directory); it != fs::directory_iterator(); ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == ".yul")
+			sources.push_back({it->path().stem().string(), readFileAsString(it->path().string())});
+	sort(sources.begin(), sources.end(), [](YulSource const& _a, YulSource const& _b) { return _a.name < _b.name; });
+	return sources;
+}
+
+/// @returns up to @a _maxCount files with the given extension and at most @a _maxBytes bytes
+/// from @a _directory and its subdirectories, in a deterministic order.
+vector<string> loadFuzzerInputs(fs::path const& _directory, string const& _extension, size_t _maxBytes, size_t _maxCount)
+{
+	vector<fs::path> paths;
+	if (fs::is_directory(_directory))
+		for (fs::recursive_directory_iterator it(_directory); it != fs::recursive_directory_iterator(); ++it)
+			if (fs::is_regular_file(it->path()) && it->path().extension() == _extension && fs::file_size(it->path()) <= _maxBytes)
+				paths.push_back(it->path());
+	sort(paths.begin(), paths.end());
+	if (paths.size() > _maxCount)
+		paths.resize(_maxCount);
+
+	vector<string> inputs;
+	for (auto const& path: paths)
+		inputs.push_back(readFileAsString(path.string()));
+	return inputs;
+}
+
+/// @returns a contract with @a _functions functions that exercise expressions, control flow,
+/// storage and memory.
+Project stressSolidity(unsigned _functions)
+{
+	string source = "pragma solidity >=0.0;\n\ncontract Stress {\n";
+	source += "\tstruct S { uint a; uint b; bytes32 c; }\n";
+	source += "\tmapping(uint => S) data;\n";
+	source += "\tuint[] values;\n";
+	source += "\tevent Changed(uint indexed key, uint value);\n";
+	for (unsigned i = 0; i < _functions; ++i)
+	{
+		string n = to_string(i);
+		source +=
+			"\tfunction f" + n + "(uint x, uint y) public returns (uint r) {\n"
+			"\t\tuint[] memory tmp = new uint[](x % 8 + 1);\n"
+			"\t\tfor (uint i = 0; i < tmp.length; i++)\n"
+			"\t\t\ttmp[i] = (x + i * " + n + ") * (y | " + to_string(i * 7 + 3) + ") ^ (x << 3);\n"
+			"\t\tS storage s = data[x + " + n + "];\n"
+			"\t\tif (s.a > y)\n"
+			"\t\t\ts.b = s.a - y;\n"
+			"\t\telse\n"
+			"\t\t\ts.b += tmp[tmp.length - 1] / (y + 1);\n"
+			"\t\ts.c = keccak256(abi.encodePacked(s.a, s.b, uint(" + n + ")));\n"
+			"\t\tvalues.push(s.b);\n"
+			"\t\temit Changed(x, s.b);\n"
+			"\t\tr = uint(s.c) % (values.length + " + n + ") + tmp[0];\n"
+			"\t}\n";
+	}
+	source += "}\n";
+	return {"stress", {{"stress.sol", source}}};
+}
+
+/// @returns a Yul block with @a _functions functions calling each other in a chain.
+YulSource stressYul(unsigned _functions)
+{
+	string source = "{\n";
+	for (unsigned i = 0; i < _functions; ++i)
+	{
+		string n = to_string(i);
+		source +=
+			"\tfunction f" + n + "(a, b) -> r {\n"
+			"\t\tlet x := add(mul(a, " + to_string(i + 2) + "), b)\n"
+			"\t\tlet y := and(mload(add(0x40, mul(" + n + ", 0x20))), 0xffff)\n"
+			"\t\tfor { let i := 0 } lt(i, a) { i := add(i, 1) } {\n"
+			"\t\t\tx := xor(x, keccak256(0, add(i, 0x20)))\n"
+			"\t\t\tif gt(x, y) { y := sub(x, y) }\n"
+			"\t\t}\n"
+			"\t\tswitch mod(x, 3)\n"
+			"\t\tcase 0 { r := add(y, sload(x)) }\n"
+			"\t\tcase 1 { r := mul(y, 2) sstore(y, r) }\n"
+			"\t\tdefault { r := sub(x, y) }\n";
+		if (i > 0)
+			source += "\t\tr := add(r, f" + to_string(i - 1) + "(sub(a, 1), r))\n";
+		source += "\t}\n";
+	}
+	source += "\tsstore(0, f" + to_string(_functions - 1) + "(calldataload(0), calldataload(0x20)))\n}\n";
+	return {"stress", source};
+}
+
+void benchmarkProject(BenchmarkRunner& _runner, Project const& _project, EVMVersion _evmVersion)
+{
+	size_t const bytes = _project.size();
+
+	_runner.run("scanner/" + _project.name, bytes, [&]() {
+		for (auto const& source: _project.sources)
+		{
+			Scanner scanner(CharStream(source.second, source.first));
+			while (scanner.currentToken() != Token::EOS)
+				scanner.next();
+		}
+		return -1.0;
+	});
+
+	_runner.run("parser/" + _project.name, bytes, [&]() {
+		for (auto const& source: _project.sources)
+		{
+			ErrorList errors;
+			ErrorReporter errorReporter(errors);
+			auto scanner = make_shared<Scanner>(CharStream(source.second, source.first));
+			if (!Parser(errorReporter).parse(scanner) || hasErrors(errors))
+			{
+				printErrors(errors, "Parsing " + source.first + " failed.");
+				BOOST_THROW_EXCEPTION(Exception());
+			}
+		}
+		return -1.0;
+	});
+
+	auto compileWithProfile = [&](OptimiserSettings const& _settings, bool _generateCode) {
+		CompilerStack compiler;
+		compiler.setSources(_project.sources);
+		compiler.setEVMVersion(_evmVersion);
+		compiler.setOptimiserSettings(_settings);
+		Profiler::instance().reset();
+		Profiler::instance().enable();
+		bool success = _generateCode ? compiler.compile() : compiler.parseAndAnalyze();
+		Profiler::instance().enable(false);
+		if (!success)
+		{
+			printErrors(compiler.errors(), "Compiling " + _project.name + " failed.");
+			BOOST_THROW_EXCEPTION(Exception());
+		}
+		return Profiler::instance().toJson()["phases"];
+	};
+
+	_runner.run("analysis/" + _project.name, bytes, [&]() {
+		return phaseTime(compileWithProfile(OptimiserSettings::minimal(), false), "analysis");
+	});
+	_runner.run("codegen/" + _project.name, bytes, [&]() {
+		return phaseTime(compileWithProfile(OptimiserSettings::minimal(), true), "code generation");
+	});
+	_runner.run("evmasm-optimiser/" + _project.name, bytes, [&]() {
+		return phaseTime(compileWithProfile(OptimiserSettings::standard(), true), "evmasm optimiser");
+	});
+
+	Json::Value input(Json::objectValue);
+	input["language"] = "Solidity";
+	for (auto const& source: _project.sources)
+		input["sources"][source.first]["content"] = source.second;
+	input["settings"]["evmVersion"] = _evmVersion.name();
+	input["settings"]["optimizer"]["enabled"] = true;
+	Json::Value& selection = input["settings"]["outputSelection"]["*"];
+	for (char const* output: {"abi", "metadata", "evm.bytecode", "evm.deployedBytecode", "evm.methodIdentifiers"})
+		selection["*"].append(output);
+	selection[""].append("ast");
+
+	_runner.run("standard-json/" + _project.name, bytes, [&]() {
+		Json::Value output = StandardCompiler().compile(input);
+		for (auto const& error: output.get("errors", Json::arrayValue))
+			if (error["severity"].asString() != "warning")
+			{
+				cerr << "Standard JSON compilation of " << _project.name << " failed:" << endl;
+				cerr << error["formattedMessage"].asString() << endl;
+				BOOST_THROW_EXCEPTION(Exception());
+			}
+		return -1.0;
+	});
+}
+
+void benchmarkYul(BenchmarkRunner& _runner, YulSource const& _source, EVMVersion _evmVersion)
+{
+	_runner.run("yul-optimiser/" + _source.name, _source.source.size(), [&]() {
+		yul::AssemblyStack stack(_evmVersion, yul::AssemblyStack::Language::StrictAssembly, OptimiserSettings::full());
+		if (!stack.parseAndAnalyze(_source.name, _source.source))
+		{
+			printErrors(stack.errors(), "Analysing " + _source.name + " failed.");
+			BOOST_THROW_EXCEPTION(Exception());
+		}
+		auto start = chrono::steady_clock::now();
+		stack.optimize();
+		return double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / 1000;
+	});
+}
+
+/// Measures the conversions of 256 bit numbers that are frequent in the optimisers,
+/// the assembler and the Yul interpreter.
+void benchmarkNumbers(BenchmarkRunner& _runner)
+{
+	// Numbers of all sizes with a deterministic mix of bytes.
+	vector<u256> numbers;
+	u256 number = 1;
+	for (unsigned i = 0; i < 10000; ++i)
+	{
+		number = number * 0x100000001b3 + i;
+		numbers.push_back(number >> ((i * 7) % 256));
+	}
+	vector<bytes> encoded;
+	for (u256 const& n: numbers)
+		encoded.push_back(toCompactBigEndian(n));
+
+	size_t const bytes = numbers.size() * 32;
+	size_t sum = 0;
+	_runner.run("u256/bytes-required", bytes, [&]() {
+		for (u256 const& n: numbers)
+			sum += bytesRequired(n);
+		return -1.0;
+	}, numbers.size());
+	_runner.run("u256/to-big-endian", bytes, [&]() {
+		for (u256 const& n: numbers)
+			sum += toBigEndian(n)[31] + toCompactBigEndian(n).size();
+		return -1.0;
+	}, numbers.size());
+	_runner.run("u256/from-big-endian", bytes, [&]() {
+		for (auto const& data: encoded)
+			sum += size_t(fromBigEndian<u256>(data) & 0xff);
+		return -1.0;
+	}, numbers.size());
+	_runner.run("u256/to-hex", bytes, [&]() {
+		for (u256 const& n: numbers)
+			sum += toHex(n).size() + toCompactHexWithPrefix(n).size() + formatNumber(n).size();
+		return -1.0;
+	}, numbers.size());
+	// Storing the result in a volatile variable prevents the loops from being optimised away.
+	size_t volatile sink = sum;
+	(void)sink;
+}
+
+/// Runs the fuzz targets on a corpus of small inputs the way a persistent-mode fuzzer does,
+/// i.e. in a single process with a reset of the global state after every input.
+void benchmarkFuzzers(BenchmarkRunner& _runner, vector<string> const& _solidityInputs, vector<string> const& _yulInputs)
+{
+	auto totalSize = [](vector<string> const& _inputs) {
+		size_t size = 0;
+		for (string const& input: _inputs)
+			size += input.size();
+		return size;
+	};
+	auto runAll = [](vector<string> const& _inputs, function<void(string const&)> const& _target) {
+		return [&_inputs, _target]() {
+			for (string const& input: _inputs)
+			{
+				_target(input);
+				FuzzerUtil::resetGlobalState();
+			}
+			return -1.0;
+		};
+	};
+
+	if (!_solidityInputs.empty())
+	{
+		size_t const bytes = totalSize(_solidityInputs);
+		_runner.run("fuzzer/solc-noopt", bytes, runAll(_solidityInputs, [](string const& _input) {
+			FuzzerUtil::testCompiler(_input, false, true);
+		}), _solidityInputs.size());
+		_runner.run("fuzzer/solc-opt", bytes, runAll(_solidityInputs, [](string const& _input) {
+			FuzzerUtil::testCompiler(_input, true, true);
+		}), _solidityInputs.size());
+		_runner.run("fuzzer/const-opt", bytes, runAll(_solidityInputs, [](string const& _input) {
+			FuzzerUtil::testConstantOptimizer(_input, true);
+		}), _solidityInputs.size());
+	}
+
+	if (!_yulInputs.empty())
+	{
+		size_t const bytes = totalSize(_yulInputs);
+		_runner.run("fuzzer/strictasm-opt", bytes, runAll(_yulInputs, [](string const& _input) {
+			yul::AssemblyStack stack(EVMVersion(), yul::AssemblyStack::Language::StrictAssembly, OptimiserSettings::full());
+			if (stack.parseAndAnalyze("source", _input))
+			{
+				stack.optimize();
+				stack.print();
+			}
+		}), _yulInputs.size());
+		auto diff = [](string const& _input) {
+			using namespace yul::test;
+			yul::AssemblyStack stack(EVMVersion(), yul::AssemblyStack::Language::StrictAssembly, OptimiserSettings::full());
+			if (!stack.parseAndAnalyze("source", _input))
+				return;
+			for (bool optimized: {false, true})
+			{
+				if (optimized)
+					stack.optimize();
+				InterpreterState state;
+				try
+				{
+					yul_fuzzer::yulFuzzerUtil::interpret(state, stack.parserResult()->code);
+				}
+				catch (InterpreterTerminatedGeneric const&)
+				{
+				}
+			}
+		};
+		// The interpreter does not support the builtins for objects, so inputs using them are skipped.
+		vector<string> interpretableInputs;
+		for (string const& input: _yulInputs)
+			try
+			{
+				diff(input);
+				interpretableInputs.push_back(input);
+			}
+			catch (Exception const&)
+			{
+			}
+		FuzzerUtil::resetGlobalState();
+		_runner.run(
+			"fuzzer/strictasm-diff",
+			totalSize(interpretableInputs),
+			runAll(interpretableInputs, diff),
+			interpretableInputs.size()
+		);
+	}
+}
+
+/// Compares the median times of @a _results against @a _baseline.
+/// @returns false if any benchmark got slower by more than @a _tolerance percent.
+bool compareToBaseline(Json::Value const& _results, Json::Value const& _baseline, double _tolerance)
+{
+	map<string, double> baseline;
+	for (auto const& result: _baseline["benchmarks"])
+		baseline[result["name"].asString()] = result["medianMicroseconds"].asDouble();
+
+	bool success = true;
+	for (auto const& result: _results)
+	{
+		string name = result["name"].asString();
+		if (!baseline.count(name) || baseline[name] <= 0)
+			continue;
+		double change = 100 * (result["medianMicroseconds"].asDouble() / baseline[name] - 1);
+		bool regression = change > _tolerance;
+		cerr << (boost::format("%-48s %+8.1f%%%s") % name % change % (regression ? "  REGRESSION" : "")) << endl;
+		if (regression)
+			success = false;
+	}
+	return success;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, benchmarks of the compiler itself.
+Usage: solbench [Options]
+Measures scanning, parsing, analysis, code generation, both optimizers and
+Standard JSON compilation on the compilation tests, the Yul optimizer tests
+and generated inputs, conversions of 256 bit numbers, as well as the throughput
+of the fuzz targets on small syntax and optimizer tests. The results are written as JSON to standard output.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		(
+			"testpath",
+			po::value<string>()->value_name("path"),
+			"Path to the test directory (defaults to ./test)."
+		)
+		(
+			"repetitions",
+			po::value<unsigned>()->value_name("count")->default_value(5),
+			"Number of measured runs of every benchmark (after one warm-up run)."
+		)
+		(
+			"filter",
+			po::value<string>()->value_name("text")->default_value(""),
+			"Only run benchmarks whose name contains the given text."
+		)
+		(
+			"stress-size",
+			po::value<unsigned>()->value_name("functions")->default_value(100),
+			"Number of functions in the generated inputs. Zero disables them."
+		)
+		(
+			"output",
+			po::value<string>()->value_name("file"),
+			"Write the results to the given file instead of standard output."
+		)
+		(
+			"baseline",
+			po::value<string>()->value_name("file"),
+			"Compare the results to a previous output of solbench and exit with "
+			"status 2 if a benchmark got slower by more than the tolerance."
+		)
+		(
+			"tolerance",
+			po::value<double>()->value_name("percent")->default_value(10),
+			"Allowed slowdown relative to the baseline."
+		);
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	fs::path testPath = arguments.count("testpath") ? fs::path(arguments["testpath"].as<string>()) : fs::path("test");
+	if (!fs::is_directory(testPath / "compilationTests"))
+	{
+		cerr << "Compilation tests not found in " << testPath << ". Use --testpath." << endl;
+		return 1;
+	}
+
+	unsigned repetitions = max(arguments["repetitions"].as<unsigned>(), 1u);
+	unsigned stressSize = arguments["stress-size"].as<unsigned>();
+	EVMVersion evmVersion;
+	BenchmarkRunner runner(repetitions, arguments["filter"].as<string>());
+
+	vector<Project> projects = loadProjects(testPath / "compilationTests");
+	vector<YulSource> yulSources = loadYulSources(testPath / "libyul" / "yulOptimizerTests" / "fullSuite");
+	if (stressSize > 0)
+	{
+		projects.push_back(stressSolidity(stressSize));
+		yulSources.push_back(stressYul(stressSize));
+	}
+
+	try
+	{
+		for (Project const& project: projects)
+			benchmarkProject(runner, project, evmVersion);
+		for (YulSource const& source: yulSources)
+			benchmarkYul(runner, source, evmVersion);
+		benchmarkNumbers(runner);
+		benchmarkFuzzers(
+			runner,
+			loadFuzzerInputs(testPath / "libsolidity" / "syntaxTests", ".sol", 600, 100),
+			loadFuzzerInputs(testPath / "libyul" / "yulOptimizerTests", ".yul", 600, 100)
+		);
+	}
+	catch (Exception const&)
+	{
+		return 1;
+	}
+
+	Json::Value output(Json::objectValue);
+	output["version"] = 1;
+	output["repetitions"] = repetitions;
+	output["benchmarks"] = runner.results();
+	if (arguments.count("output"))
+	{
+		ofstream file(arguments["output"].as<string>());
+		file << jsonPrettyPrint(output) << endl;
+	}
+	else
+		cout << jsonPrettyPrint(output) << endl;
+
+	if (arguments.count("baseline"))
+	{
+		Json::Value baseline;
+		if (!jsonParseStrict(readFileAsString(arguments["baseline"].as<string>()), baseline))
+		{
+			cerr << "Could not parse the baseline." << endl;
+			return 1;
+		}
+		if (!compareToBaseline(runner.results(), baseline, arguments["tolerance"].as<double>()))
+			return 2;
+	}
+
+	return 0;
+}
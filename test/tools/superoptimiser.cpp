@@ -0,0 +1,464 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Superoptimiser that generates the rules of the peephole optimiser in
+ * libevmasm/SuperoptimisedRules.h: Collects short sequences of stack instructions from
+ * the optimised assembly of the test contracts and searches for cheaper sequences
+ * that are equivalent under symbolic evaluation.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libevmasm/ExpressionClasses.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+#include <libevmasm/SuperoptimisedRules.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::solidity;
+using namespace langutil;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+using Sequence = vector<Instruction>;
+
+/// Stack usage of a sequence relative to the stack height before it.
+struct StackEffect
+{
+	/// Number of elements of the initial stack that are accessed.
+	int depth = 0;
+	/// Largest stack height reached.
+	int maxHeight = 0;
+	/// Stack height at the end.
+	int height = 0;
+
+	void add(Instruction _instruction)
+	{
+		InstructionInfo info = instructionInfo(_instruction);
+		depth = max(depth, info.args - height);
+		height += info.ret - info.args;
+		maxHeight = max(maxHeight, height);
+	}
+};
+
+StackEffect stackEffect(Sequence const& _sequence)
+{
+	StackEffect effect;
+	for (Instruction instruction: _sequence)
+		effect.add(instruction);
+	return effect;
+}
+
+unsigned gas(Sequence const& _sequence)
+{
+	unsigned gas = 0;
+	for (Instruction instruction: _sequence)
+		gas += GasMeter::runGas(instruction);
+	return gas;
+}
+
+string toString(Sequence const& _sequence, string const& _prefix = "", string const& _separator = " ")
+{
+	string result;
+	for (Instruction instruction: _sequence)
+		result += (result.empty() ? "" : _separator) + _prefix + instructionInfo(instruction).name;
+	return result;
+}
+
+/// @returns true if @a _instruction can be part of a rule: It only operates on the stack
+/// and its result only depends on its arguments and on values that are constant during a call.
+/// Instructions with costs that depend on the EVM version or the arguments are excluded.
+bool isStackOperation(Instruction _instruction)
+{
+	if (
+		SemanticInformation::isDupInstruction(_instruction) ||
+		SemanticInformation::isSwapInstruction(_instruction) ||
+		_instruction == Instruction::POP
+	)
+		return true;
+	InstructionInfo info = instructionInfo(_instruction);
+	return
+		!isPushInstruction(_instruction) &&
+		SemanticInformation::movable(_instruction) &&
+		info.ret <= 1 &&
+		info.gasPriceTier != Tier::Special;
+}
+
+/// Counts all sequences of stack operations of two up to @a _maxLength items in @a _items.
+void collectWindows(AssemblyItems const& _items, size_t _maxLength, map<Sequence, size_t>& _counts)
+{
+	Sequence run;
+	auto flush = [&]()
+	{
+		for (size_t start = 0; start < run.size(); ++start)
+			for (size_t length = 2; length <= _maxLength && start + length <= run.size(); ++length)
+				++_counts[Sequence(run.begin() + start, run.begin() + start + length)];
+		run.clear();
+	};
+	for (AssemblyItem const& item: _items)
+		if (item.type() == Operation && isStackOperation(item.instruction()))
+			run.push_back(item.instruction());
+		else
+			flush();
+	flush();
+}
+
+/// Exhaustive search for the cheapest sequence that is shorter than a given window,
+/// does not cost more gas, does not access more of the stack and results in the same
+/// stack contents. Values are compared as expression classes, so commutativity and
+/// the simplification rules of the optimiser are taken into account.
+class Search
+{
+public:
+	explicit Search(Sequence const& _window):
+		m_window(_window),
+		m_windowEffect(stackEffect(_window)),
+		m_bestGas(gas(_window))
+	{
+		for (Instruction instruction: m_window)
+			m_target.feedItem(AssemblyItem(instruction), true);
+		for (int i = 1; i <= min(16, m_windowEffect.depth); ++i)
+			m_alphabet.push_back(Instruction(unsigned(Instruction::DUP1) + i - 1));
+		for (int i = 1; i <= min(16, m_windowEffect.depth - 1); ++i)
+			m_alphabet.push_back(Instruction(unsigned(Instruction::SWAP1) + i - 1));
+		m_alphabet.push_back(Instruction::POP);
+		for (Instruction instruction: m_window)
+			if (find(m_alphabet.begin(), m_alphabet.end(), instruction) == m_alphabet.end())
+				m_alphabet.push_back(instruction);
+	}
+
+	/// @returns the best sequence found, if any.
+	boost::optional<Sequence> run()
+	{
+		search(KnownState(m_classes), StackEffect{}, 0);
+		return m_best;
+	}
+
+private:
+	void search(KnownState const& _state, StackEffect const& _effect, unsigned _gas)
+	{
+		if (_gas > m_bestGas)
+			return;
+		if (_effect.height == m_windowEffect.height && sameStack(_state))
+			if (!m_best || _gas < m_bestGas || m_current.size() < m_best->size())
+			{
+				m_best = m_current;
+				m_bestGas = _gas;
+			}
+		if (m_current.size() + 2 > m_window.size())
+			return;
+		for (Instruction instruction: m_alphabet)
+		{
+			StackEffect effect = _effect;
+			effect.add(instruction);
+			if (effect.depth > m_windowEffect.depth || effect.maxHeight > m_windowEffect.maxHeight)
+				continue;
+			KnownState state = _state;
+			state.feedItem(AssemblyItem(instruction), true);
+			m_current.push_back(instruction);
+			search(state, effect, _gas + GasMeter::runGas(instruction));
+			m_current.pop_back();
+		}
+	}
+
+	bool sameStack(KnownState _state)
+	{
+		for (int height = 1 - m_windowEffect.depth; height <= m_windowEffect.height; ++height)
+			if (_state.stackElement(height, {}) != m_target.stackElement(height, {}))
+				return false;
+		return true;
+	}
+
+	Sequence m_window;
+	StackEffect m_windowEffect;
+	shared_ptr<ExpressionClasses> m_classes = make_shared<ExpressionClasses>();
+	KnownState m_target{m_classes};
+	Sequence m_alphabet;
+	Sequence m_current;
+	boost::optional<Sequence> m_best;
+	unsigned m_bestGas;
+};
+
+unsigned savedGas(Sequence const& _pattern, Sequence const& _replacement)
+{
+	return gas(_pattern) - gas(_replacement);
+}
+
+/// Adds rules for all windows found at least @a _minCount times to @a _rules. Windows that
+/// contain a shorter pattern with a rule that saves at least as much gas are skipped.
+/// @returns the number of rules added.
+size_t findRules(
+	map<Sequence, size_t> const& _windows,
+	size_t _minCount,
+	size_t _maxLength,
+	map<Sequence, Sequence>& _rules
+)
+{
+	size_t added = 0;
+	for (size_t length = 2; length <= _maxLength; ++length)
+		for (auto const& windowAndCount: _windows)
+		{
+			Sequence const& window = windowAndCount.first;
+			if (window.size() != length || windowAndCount.second < _minCount || _rules.count(window))
+				continue;
+			boost::optional<Sequence> replacement = Search(window).run();
+			if (!replacement)
+				continue;
+			unsigned saved = savedGas(window, *replacement);
+			bool redundant = false;
+			for (size_t start = 0; start < length && !redundant; ++start)
+				for (size_t subLength = 2; start + subLength <= length && subLength < length; ++subLength)
+				{
+					auto subRule = _rules.find(Sequence(window.begin() + start, window.begin() + start + subLength));
+					if (subRule != _rules.end() && savedGas(subRule->first, subRule->second) >= saved)
+						redundant = true;
+				}
+			if (redundant)
+				continue;
+			cerr << toString(window) << " -> " << toString(*replacement);
+			cerr << " (found " << windowAndCount.second << " times)" << endl;
+			_rules[window] = *replacement;
+			++added;
+		}
+	return added;
+}
+
+string generateHeader(map<Sequence, Sequence> const& _rules)
+{
+	vector<pair<Sequence, Sequence>> sortedRules(_rules.begin(), _rules.end());
+	// Longer patterns first, so that they are tried before the patterns they contain.
+	stable_sort(sortedRules.begin(), sortedRules.end(), [](pair<Sequence, Sequence> const& _a, pair<Sequence, Sequence> const& _b) {
+		return _a.first.size() > _b.first.size();
+	});
+	ostringstream rules;
+	for (auto const& rule: sortedRules)
+	{
+		rules << "\t\t// " << toString(rule.first) << " -> " << toString(rule.second);
+		rules << " (saves " << savedGas(rule.first, rule.second) << " gas)\n";
+		rules << "\t\t{{" << toString(rule.first, "Instruction::", ", ") << "}, ";
+		rules << "{" << toString(rule.second, "Instruction::", ", ") << "}},\n";
+	}
+	return R"(/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file SuperoptimisedRules.h
+ * Rules for the peephole optimiser. Generated by test/tools/superoptimiser, do not edit.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+
+/// A sequence of stack operations and a shorter sequence that does not cost more gas
+/// and has the same effect on the stack.
+struct SuperoptimisedRule
+{
+	std::vector<Instruction> pattern;
+	std::vector<Instruction> replacement;
+};
+
+/// @returns the rules, longer patterns first.
+inline std::vector<SuperoptimisedRule> const& superoptimisedRules()
+{
+	static std::vector<SuperoptimisedRule> const rules{
+)" + rules.str() + R"(	};
+	return rules;
+}
+
+}
+}
+)";
+}
+
+/// @returns the paths of all Solidity sources in @a _directory and its subdirectories in a fixed order.
+vector<fs::path> sourceFiles(fs::path const& _directory)
+{
+	vector<fs::path> paths;
+	for (fs::recursive_directory_iterator it(_directory); it != fs::recursive_directory_iterator(); ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+			paths.push_back(it->path());
+	sort(paths.begin(), paths.end());
+	return paths;
+}
+
+/// @returns the compilation tests, one project per directory, and the semantic tests,
+/// one project per file.
+vector<StringMap> loadProjects(fs::path const& _testPath)
+{
+	vector<StringMap> projects;
+	vector<fs::path> directories(
+		fs::directory_iterator(_testPath / "compilationTests"),
+		fs::directory_iterator()
+	);
+	sort(directories.begin(), directories.end());
+	for (fs::path const& directory: directories)
+		if (fs::is_directory(directory))
+		{
+			StringMap sources;
+			for (fs::path const& file: sourceFiles(directory))
+				// Source names are relative to the project so that relative imports resolve.
+				sources[file.string().substr(directory.string().size() + 1)] = readFileAsString(file.string());
+			if (!sources.empty())
+				projects.emplace_back(move(sources));
+		}
+	for (fs::path const& file: sourceFiles(_testPath / "libsolidity" / "semanticTests"))
+		projects.push_back({{file.filename().string(), readFileAsString(file.string())}});
+	return projects;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(superoptimiser, generator of peephole optimiser rules.
+Usage: superoptimiser [Options]
+Compiles the compilation and semantic tests with the optimiser, collects sequences
+of stack operations from the assembly, searches for shorter and cheaper sequences
+with the same effect and writes them together with the rules the compiler already
+uses as libevmasm/SuperoptimisedRules.h to standard output.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		(
+			"testpath",
+			po::value<string>()->value_name("path"),
+			"Path to the test directory (defaults to ./test)."
+		)
+		(
+			"window",
+			po::value<size_t>()->value_name("length")->default_value(4),
+			"Maximum length of the instruction sequences."
+		)
+		(
+			"min-count",
+			po::value<size_t>()->value_name("count")->default_value(2),
+			"Only consider sequences that occur at least this often."
+		)
+		(
+			"output",
+			po::value<string>()->value_name("file"),
+			"Write the rules to the given file instead of standard output."
+		);
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	fs::path testPath = arguments.count("testpath") ? fs::path(arguments["testpath"].as<string>()) : fs::path("test");
+	if (!fs::is_directory(testPath / "compilationTests"))
+	{
+		cerr << "Compilation tests not found in " << testPath << ". Use --testpath." << endl;
+		return 1;
+	}
+	size_t maxLength = max<size_t>(arguments["window"].as<size_t>(), 2);
+
+	vector<StringMap> projects = loadProjects(testPath);
+	map<Sequence, size_t> windows;
+	for (StringMap const& project: projects)
+	{
+		CompilerStack compiler;
+		compiler.setSources(project);
+		compiler.setOptimiserSettings(OptimiserSettings::standard());
+		if (!compiler.compile())
+		{
+			cerr << "Skipping " << project.begin()->first << ", it does not compile." << endl;
+			continue;
+		}
+		for (string const& contract: compiler.contractNames())
+			for (AssemblyItems const* items: {compiler.assemblyItems(contract), compiler.runtimeAssemblyItems(contract)})
+				if (items)
+					collectWindows(*items, maxLength, windows);
+	}
+	cerr << "Compiled " << projects.size() << " projects, found " << windows.size() << " distinct sequences." << endl;
+
+	// The current rules are kept. They are already applied to the assembly, so their
+	// patterns are not found again.
+	map<Sequence, Sequence> rules;
+	for (SuperoptimisedRule const& rule: superoptimisedRules())
+		rules[rule.pattern] = rule.replacement;
+	size_t added = findRules(windows, arguments["min-count"].as<size_t>(), maxLength, rules);
+	cerr << "Found " << added << " new rules, " << rules.size() << " in total." << endl;
+
+	string header = generateHeader(rules);
+	if (arguments.count("output"))
+	{
+		ofstream file(arguments["output"].as<string>());
+		file << header;
+	}
+	else
+		cout << header;
+	return 0;
+}
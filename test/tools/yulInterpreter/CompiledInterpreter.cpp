@@ -0,0 +1,566 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter that lowers the code into closures before running it.
+ */
+
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/optional.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+
+#include <functional>
+#include <map>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+using namespace yul::test;
+
+namespace
+{
+
+/// How execution continues after a statement.
+enum class Flow
+{
+	Next,
+	Continue,
+	Break
+};
+
+/// State of a single run of the code.
+struct Context
+{
+	explicit Context(InterpreterState& _state): state(_state) {}
+
+	u256& slot(size_t _slot) { return slots[base + _slot]; }
+
+	InterpreterState& state;
+	/// Frames of all active function calls, the innermost one last.
+	vector<u256> slots;
+	/// Start of the frame of the current function in @a slots.
+	size_t base = 0;
+};
+
+using CompiledExpression = function<u256(Context&)>;
+using CompiledStatement = function<Flow(Context&)>;
+
+struct CompiledFunction
+{
+	/// The parameters are stored in the first slots of the frame, followed by the
+	/// return variables and the local variables.
+	size_t parameters = 0;
+	size_t frameSize = 0;
+	CompiledStatement body;
+};
+
+/// Evaluates the arguments from right to left, runs the function and calls
+/// @a _handleResults with a pointer to the return values, which is only valid
+/// during that call.
+template <class ResultHandler>
+void callFunction(
+	Context& _context,
+	CompiledFunction const& _function,
+	vector<CompiledExpression> const& _arguments,
+	ResultHandler const& _handleResults
+)
+{
+	// Function calls in the arguments push their frames on top of this one.
+	size_t frame = _context.slots.size();
+	_context.slots.resize(frame + _function.frameSize);
+	for (size_t i = _arguments.size(); i-- > 0;)
+	{
+		u256 value = _arguments[i](_context);
+		_context.slots[frame + i] = std::move(value);
+	}
+	size_t callerBase = _context.base;
+	_context.base = frame;
+	_function.body(_context);
+	_context.base = callerBase;
+	_handleResults(_context.slots.data() + frame + _function.parameters);
+	_context.slots.resize(frame);
+}
+
+/**
+ * Lowers the AST into closures, resolving variables to slots in the frame of
+ * the enclosing function and function calls to the function they refer to.
+ */
+class Compiler
+{
+public:
+	explicit Compiler(vector<unique_ptr<CompiledFunction>>& _functions): m_functions(_functions) {}
+
+	CompiledExpression operator()(Literal const& _literal);
+	CompiledExpression operator()(Identifier const& _identifier);
+	CompiledExpression operator()(FunctionalInstruction const& _instr);
+	CompiledExpression operator()(FunctionCall const& _funCall);
+
+	CompiledStatement operator()(ExpressionStatement const& _statement);
+	CompiledStatement operator()(Instruction const&);
+	CompiledStatement operator()(Label const&);
+	CompiledStatement operator()(StackAssignment const&);
+	CompiledStatement operator()(Assignment const& _assignment);
+	CompiledStatement operator()(VariableDeclaration const& _varDecl);
+	CompiledStatement operator()(If const& _if);
+	CompiledStatement operator()(Switch const& _switch);
+	CompiledStatement operator()(FunctionDefinition const&);
+	CompiledStatement operator()(ForLoop const& _forLoop);
+	CompiledStatement operator()(Break const&);
+	CompiledStatement operator()(Continue const&);
+	CompiledStatement operator()(Block const& _block);
+
+	/// Lowers the body of a function into @a _function. The body is run in its own
+	/// frame, with the parameters and return variables in its first slots.
+	void compileFunction(
+		vector<TypedName> const& _parameters,
+		vector<TypedName> const& _returnVariables,
+		Block const& _body,
+		CompiledFunction& _function
+	);
+
+private:
+	template <class Result>
+	struct Dispatcher: boost::static_visitor<Result>
+	{
+		explicit Dispatcher(Compiler& _compiler): compiler(_compiler) {}
+		template <class Node>
+		Result operator()(Node const& _node) const { return compiler(_node); }
+		Compiler& compiler;
+	};
+
+	CompiledExpression compile(Expression const& _expression)
+	{
+		return boost::apply_visitor(Dispatcher<CompiledExpression>(*this), _expression);
+	}
+	CompiledStatement compile(Statement const& _statement)
+	{
+		return boost::apply_visitor(Dispatcher<CompiledStatement>(*this), _statement);
+	}
+	vector<CompiledExpression> compileArguments(vector<Expression> const& _arguments);
+	/// @returns a statement that calls the function and assigns its return values to the slots.
+	static CompiledStatement callAndAssign(
+		CompiledFunction const& _function,
+		vector<CompiledExpression> _arguments,
+		vector<size_t> _slots
+	);
+
+	size_t slotOf(YulString _variable) const;
+	CompiledFunction const& lookupFunction(YulString _name) const;
+
+	size_t declareVariable(YulString _name);
+	void openScope();
+	void closeScope();
+
+	vector<unique_ptr<CompiledFunction>>& m_functions;
+	/// Slots of the variables visible in the current function, by scope.
+	vector<map<YulString, size_t>> m_variableScopes;
+	/// Functions visible at the current point, by scope.
+	vector<map<YulString, CompiledFunction const*>> m_functionScopes;
+	/// Number of slots used by the variables in scope.
+	size_t m_usedSlots = 0;
+	/// Number of slots needed by the current function.
+	size_t m_frameSize = 0;
+};
+
+CompiledExpression Compiler::operator()(Literal const& _literal)
+{
+	u256 value = valueOfLiteral(_literal);
+	return [value](Context&) { return value; };
+}
+
+CompiledExpression Compiler::operator()(Identifier const& _identifier)
+{
+	size_t slot = slotOf(_identifier.name);
+	return [slot](Context& _context) { return _context.slot(slot); };
+}
+
+CompiledExpression Compiler::operator()(FunctionalInstruction const& _instr)
+{
+	dev::eth::Instruction instruction = _instr.instruction;
+	vector<CompiledExpression> arguments = compileArguments(_instr.arguments);
+	return [instruction, arguments](Context& _context)
+	{
+		/// Arguments are evaluated in reverse.
+		vector<u256> values(arguments.size());
+		for (size_t i = arguments.size(); i-- > 0;)
+			values[i] = arguments[i](_context);
+		// The instruction might also return nothing, but it does not
+		// hurt to use the value in that case.
+		return EVMInstructionInterpreter(_context.state).eval(instruction, values);
+	};
+}
+
+CompiledExpression Compiler::operator()(FunctionCall const& _funCall)
+{
+	CompiledFunction const* function = &lookupFunction(_funCall.functionName.name);
+	vector<CompiledExpression> arguments = compileArguments(_funCall.arguments);
+	return [function, arguments](Context& _context)
+	{
+		u256 result;
+		callFunction(_context, *function, arguments, [&](u256 const* _values) { result = _values[0]; });
+		return result;
+	};
+}
+
+CompiledStatement Compiler::operator()(ExpressionStatement const& _statement)
+{
+	if (_statement.expression.type() == typeid(FunctionCall))
+	{
+		FunctionCall const& funCall = boost::get<FunctionCall>(_statement.expression);
+		return callAndAssign(lookupFunction(funCall.functionName.name), compileArguments(funCall.arguments), {});
+	}
+	CompiledExpression expression = compile(_statement.expression);
+	return [expression](Context& _context)
+	{
+		expression(_context);
+		return Flow::Next;
+	};
+}
+
+CompiledStatement Compiler::operator()(Instruction const&)
+{
+	solAssert(false, "Instructions are not supported by the interpreter.");
+	return {};
+}
+
+CompiledStatement Compiler::operator()(Label const&)
+{
+	solAssert(false, "Labels are not supported by the interpreter.");
+	return {};
+}
+
+CompiledStatement Compiler::operator()(StackAssignment const&)
+{
+	solAssert(false, "Stack assignments are not supported by the interpreter.");
+	return {};
+}
+
+CompiledStatement Compiler::operator()(Assignment const& _assignment)
+{
+	solAssert(_assignment.value, "");
+	vector<size_t> slots;
+	for (auto const& variable: _assignment.variableNames)
+		slots.emplace_back(slotOf(variable.name));
+
+	if (slots.size() != 1)
+	{
+		FunctionCall const& funCall = boost::get<FunctionCall>(*_assignment.value);
+		return callAndAssign(lookupFunction(funCall.functionName.name), compileArguments(funCall.arguments), move(slots));
+	}
+	size_t slot = slots.front();
+	CompiledExpression value = compile(*_assignment.value);
+	return [slot, value](Context& _context)
+	{
+		u256 result = value(_context);
+		_context.slot(slot) = std::move(result);
+		return Flow::Next;
+	};
+}
+
+CompiledStatement Compiler::operator()(VariableDeclaration const& _varDecl)
+{
+	// The value is lowered first, since the new variables are not visible to it.
+	CompiledFunction const* function = nullptr;
+	vector<CompiledExpression> arguments;
+	CompiledExpression value;
+	if (_varDecl.value && _varDecl.variables.size() != 1)
+	{
+		FunctionCall const& funCall = boost::get<FunctionCall>(*_varDecl.value);
+		function = &lookupFunction(funCall.functionName.name);
+		arguments = compileArguments(funCall.arguments);
+	}
+	else if (_varDecl.value)
+		value = compile(*_varDecl.value);
+
+	vector<size_t> slots;
+	for (auto const& variable: _varDecl.variables)
+		slots.emplace_back(declareVariable(variable.name));
+
+	if (function)
+		return callAndAssign(*function, move(arguments), move(slots));
+	else if (value)
+	{
+		size_t slot = slots.front();
+		return [slot, value](Context& _context)
+		{
+			u256 result = value(_context);
+			_context.slot(slot) = std::move(result);
+			return Flow::Next;
+		};
+	}
+	else
+		return [slots](Context& _context)
+		{
+			for (size_t slot: slots)
+				_context.slot(slot) = 0;
+			return Flow::Next;
+		};
+}
+
+CompiledStatement Compiler::operator()(If const& _if)
+{
+	solAssert(_if.condition, "");
+	CompiledExpression condition = compile(*_if.condition);
+	CompiledStatement body = (*this)(_if.body);
+	return [condition, body](Context& _context)
+	{
+		if (condition(_context) != 0)
+			return body(_context);
+		return Flow::Next;
+	};
+}
+
+CompiledStatement Compiler::operator()(Switch const& _switch)
+{
+	solAssert(_switch.expression, "");
+	solAssert(!_switch.cases.empty(), "");
+	CompiledExpression expression = compile(*_switch.expression);
+	vector<pair<boost::optional<u256>, CompiledStatement>> cases;
+	for (auto const& c: _switch.cases)
+	{
+		boost::optional<u256> value;
+		if (c.value)
+			value = valueOfLiteral(*c.value);
+		cases.emplace_back(value, (*this)(c.body));
+	}
+	return [expression, cases](Context& _context)
+	{
+		u256 value = expression(_context);
+		for (auto const& c: cases)
+			// Default case has to be last.
+			if (!c.first || *c.first == value)
+				return c.second(_context);
+		return Flow::Next;
+	};
+}
+
+CompiledStatement Compiler::operator()(FunctionDefinition const&)
+{
+	// Functions are lowered together with the block they are defined in.
+	return [](Context&) { return Flow::Next; };
+}
+
+CompiledStatement Compiler::operator()(ForLoop const& _forLoop)
+{
+	solAssert(_forLoop.condition, "");
+
+	openScope();
+	vector<CompiledStatement> pre;
+	for (auto const& statement: _forLoop.pre.statements)
+		pre.emplace_back(compile(statement));
+	CompiledExpression condition = compile(*_forLoop.condition);
+	CompiledStatement body = (*this)(_forLoop.body);
+	CompiledStatement post = (*this)(_forLoop.post);
+	closeScope();
+
+	return [pre, condition, body, post](Context& _context)
+	{
+		for (auto const& statement: pre)
+			statement(_context);
+		while (condition(_context) != 0)
+		{
+			if (body(_context) == Flow::Break)
+				break;
+			post(_context);
+		}
+		return Flow::Next;
+	};
+}
+
+CompiledStatement Compiler::operator()(Break const&)
+{
+	return [](Context&) { return Flow::Break; };
+}
+
+CompiledStatement Compiler::operator()(Continue const&)
+{
+	return [](Context&) { return Flow::Continue; };
+}
+
+CompiledStatement Compiler::operator()(Block const& _block)
+{
+	openScope();
+	// Register functions first, so that they can be called before their definition.
+	vector<pair<FunctionDefinition const*, CompiledFunction*>> functions;
+	for (auto const& statement: _block.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			FunctionDefinition const& funDef = boost::get<FunctionDefinition>(statement);
+			m_functions.emplace_back(make_unique<CompiledFunction>());
+			m_functionScopes.back()[funDef.name] = m_functions.back().get();
+			functions.emplace_back(&funDef, m_functions.back().get());
+		}
+	for (auto const& function: functions)
+		compileFunction(function.first->parameters, function.first->returnVariables, function.first->body, *function.second);
+
+	vector<CompiledStatement> statements;
+	for (auto const& statement: _block.statements)
+		if (statement.type() != typeid(FunctionDefinition))
+			statements.emplace_back(compile(statement));
+	closeScope();
+
+	return [statements](Context& _context)
+	{
+		InterpreterState& state = _context.state;
+		state.numSteps++;
+		if (state.maxSteps > 0 && state.numSteps >= state.maxSteps)
+		{
+			state.trace.append(InterpreterTrace::PseudoOperation::StepLimitReached);
+			throw StepLimitReached();
+		}
+		for (auto const& statement: statements)
+		{
+			Flow flow = statement(_context);
+			if (flow != Flow::Next)
+				return flow;
+		}
+		return Flow::Next;
+	};
+}
+
+void Compiler::compileFunction(
+	vector<TypedName> const& _parameters,
+	vector<TypedName> const& _returnVariables,
+	Block const& _body,
+	CompiledFunction& _function
+)
+{
+	// Functions cannot access variables of enclosing functions, but can call their functions.
+	vector<map<YulString, size_t>> variableScopes;
+	swap(variableScopes, m_variableScopes);
+	size_t usedSlots = m_usedSlots;
+	size_t frameSize = m_frameSize;
+	m_usedSlots = m_frameSize = 0;
+
+	openScope();
+	for (auto const& parameter: _parameters)
+		declareVariable(parameter.name);
+	for (auto const& returnVariable: _returnVariables)
+		declareVariable(returnVariable.name);
+	_function.parameters = _parameters.size();
+	_function.body = (*this)(_body);
+	closeScope();
+	_function.frameSize = m_frameSize;
+
+	swap(variableScopes, m_variableScopes);
+	m_usedSlots = usedSlots;
+	m_frameSize = frameSize;
+}
+
+vector<CompiledExpression> Compiler::compileArguments(vector<Expression> const& _arguments)
+{
+	vector<CompiledExpression> arguments;
+	for (auto const& argument: _arguments)
+		arguments.emplace_back(compile(argument));
+	return arguments;
+}
+
+CompiledStatement Compiler::callAndAssign(
+	CompiledFunction const& _function,
+	vector<CompiledExpression> _arguments,
+	vector<size_t> _slots
+)
+{
+	CompiledFunction const* function = &_function;
+	return [function, arguments = move(_arguments), slots = move(_slots)](Context& _context)
+	{
+		callFunction(_context, *function, arguments, [&](u256 const* _values) {
+			for (size_t i = 0; i < slots.size(); ++i)
+				_context.slot(slots[i]) = _values[i];
+		});
+		return Flow::Next;
+	};
+}
+
+size_t Compiler::slotOf(YulString _variable) const
+{
+	for (auto const& scope: m_variableScopes | boost::adaptors::reversed)
+	{
+		auto it = scope.find(_variable);
+		if (it != scope.end())
+			return it->second;
+	}
+	solAssert(false, "Variable " + _variable.str() + " not found.");
+	return 0;
+}
+
+CompiledFunction const& Compiler::lookupFunction(YulString _name) const
+{
+	for (auto const& scope: m_functionScopes | boost::adaptors::reversed)
+	{
+		auto it = scope.find(_name);
+		if (it != scope.end())
+			return *it->second;
+	}
+	solAssert(false, "Function " + _name.str() + " not found.");
+	return *m_functions.front();
+}
+
+size_t Compiler::declareVariable(YulString _name)
+{
+	size_t slot = m_usedSlots++;
+	m_frameSize = max(m_frameSize, m_usedSlots);
+	m_variableScopes.back()[_name] = slot;
+	return slot;
+}
+
+void Compiler::openScope()
+{
+	m_variableScopes.emplace_back();
+	m_functionScopes.emplace_back();
+}
+
+void Compiler::closeScope()
+{
+	// Slots of the variables of the scope can be re-used after the scope,
+	// since variables are always assigned when they are declared.
+	m_usedSlots -= m_variableScopes.back().size();
+	m_variableScopes.pop_back();
+	m_functionScopes.pop_back();
+}
+
+}
+
+struct CompiledInterpreter::Program
+{
+	/// All functions of the code, referenced by the closures.
+	vector<unique_ptr<CompiledFunction>> functions;
+	/// The outermost block, treated as a function without parameters.
+	CompiledFunction code;
+};
+
+CompiledInterpreter::CompiledInterpreter(Block const& _ast)
+{
+	auto program = make_unique<Program>();
+	Compiler(program->functions).compileFunction({}, {}, _ast, program->code);
+	m_program = move(program);
+}
+
+CompiledInterpreter::~CompiledInterpreter() = default;
+
+void CompiledInterpreter::run(InterpreterState& _state) const
+{
+	Context context(_state);
+	callFunction(context, m_program->code, {}, [](u256 const*) {});
+}
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter that lowers the code into closures before running it.
+ */
+
+#pragma once
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/AsmDataForward.h>
+
+#include <memory>
+
+namespace yul
+{
+namespace test
+{
+
+/**
+ * Yul interpreter that produces the same trace and final state as @a Interpreter,
+ * but resolves all names only once, before running the code: Variables are lowered
+ * to slots in a flat stack of frames, functions to direct references and statements
+ * and expressions to closures. Running the code does not need any name lookups and
+ * calling a function only pushes a frame.
+ *
+ * The code has to be analyzed successfully. It is not referenced after
+ * construction, so the object can be used to run it repeatedly.
+ */
+class CompiledInterpreter
+{
+public:
+	explicit CompiledInterpreter(Block const& _ast);
+	~CompiledInterpreter();
+
+	/// Runs the code on @a _state. Throws the same exceptions as @a Interpreter.
+	void run(InterpreterState& _state) const;
+
+private:
+	struct Program;
+	std::unique_ptr<Program const> m_program;
+};
+
+}
+}
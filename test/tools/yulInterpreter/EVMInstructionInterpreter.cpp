@@ -78,13 +78,16 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// continue with an infinite sequence of zero bytes beyond its end.
 /// Asserts the target is large enough to hold the copied segment.
 void copyZeroExtended(
-	bytes& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
 	yulAssert(_targetOffset + _size <= _target.size(), "");
+	bytes data(_size, 0);
 	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+		if (_sourceOffset + i < _source.size())
+			data[i] = _source[_sourceOffset + i];
+	_target.write(_targetOffset, &data);
 }
 
 }
@@ -189,7 +192,7 @@ u256 EVMInstructionInterpreter::eval(
 			return u256("0x1234cafe1234cafe1234cafe") + arg[0];
 		uint64_t offset = uint64_t(arg[0] & uint64_t(-1));
 		uint64_t size = uint64_t(arg[1] & uint64_t(-1));
-		return u256(keccak256(bytesConstRef(m_state.memory.data() + offset, size)));
+		return u256(keccak256(m_state.memory.read(offset, size)));
 	}
 	case Instruction::ADDRESS:
 		return m_state.address;
@@ -267,22 +270,24 @@ u256 EVMInstructionInterpreter::eval(
 	// --------------- memory / storage / logs ---------------
 	case Instruction::MLOAD:
 		if (logMemoryRead(arg[0], 0x20))
-			return u256(*reinterpret_cast<h256 const*>(m_state.memory.data() + size_t(arg[0])));
+			return m_state.memory.readWord(size_t(arg[0]));
 		else
 			return 0x1234 + arg[0];
 	case Instruction::MSTORE:
 		if (logMemoryWrite(arg[0], 0x20, h256(arg[1]).asBytes()))
-			*reinterpret_cast<h256*>(m_state.memory.data() + size_t(arg[0])) = h256(arg[1]);
+			m_state.memory.writeWord(size_t(arg[0]), arg[1]);
 		return 0;
 	case Instruction::MSTORE8:
 		if (logMemoryWrite(arg[0], 1, bytes{1, uint8_t(arg[1] & 0xff)}))
-			m_state.memory[size_t(arg[0])] = uint8_t(arg[1] & 0xff);
+			m_state.memory.setByte(size_t(arg[0]), uint8_t(arg[1] & 0xff));
 		return 0;
 	case Instruction::SLOAD:
-		logTrace(_instruction, arg);
+		if (m_state.traceReads)
+			logTrace(_instruction, arg);
 		return m_state.storage[h256(arg[0])];
 	case Instruction::SSTORE:
-		logTrace(Instruction::SSTORE, arg);
+		if (m_state.traceWrites)
+			logTrace(Instruction::SSTORE, arg);
 		m_state.storage[h256(arg[0])] = h256(arg[1]);
 		return 0;
 	case Instruction::PC:
@@ -295,58 +300,54 @@ u256 EVMInstructionInterpreter::eval(
 		logTrace(_instruction);
 		return 0x99;
 	case Instruction::LOG0:
-		logMemoryRead(arg[0], arg[1]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[0], arg[1]));
 		return 0;
 	case Instruction::LOG1:
-		logMemoryRead(arg[0], arg[1]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[0], arg[1]));
 		return 0;
 	case Instruction::LOG2:
-		logMemoryRead(arg[0], arg[1]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[0], arg[1]));
 		return 0;
 	case Instruction::LOG3:
-		logMemoryRead(arg[0], arg[1]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[0], arg[1]));
 		return 0;
 	case Instruction::LOG4:
-		logMemoryRead(arg[0], arg[1]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[0], arg[1]));
 		return 0;
 	// --------------- calls ---------------
 	case Instruction::CREATE:
-		logMemoryRead(arg[1], arg[2]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[1], arg[2]));
 		return 0xcccccc + arg[1];
 	case Instruction::CREATE2:
-		logMemoryRead(arg[2], arg[3]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[2], arg[3]));
 		return 0xdddddd + arg[1];
 	case Instruction::CALL:
 	case Instruction::CALLCODE:
+	{
 		// TODO assign returndata
-		logMemoryRead(arg[3], arg[4]);
+		bytes data = logExternalMemoryRead(arg[3], arg[4]);
 		logMemoryWrite(arg[5], arg[6]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, data);
 		return arg[0] & 1;
+	}
 	case Instruction::DELEGATECALL:
 	case Instruction::STATICCALL:
-		logMemoryRead(arg[2], arg[3]);
+	{
+		bytes data = logExternalMemoryRead(arg[2], arg[3]);
 		logMemoryWrite(arg[4], arg[5]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, data);
 		return 0;
+	}
 	case Instruction::RETURN:
 	{
 		bytes data;
 		if (logMemoryRead(arg[0], arg[1]))
-			data = bytesConstRef(m_state.memory.data() + size_t(arg[0]), size_t(arg[1])).toBytes();
+			data = m_state.memory.read(size_t(arg[0]), size_t(arg[1]));
 		logTrace(_instruction, arg, data);
 		throw ExplicitlyTerminated();
 	}
 	case Instruction::REVERT:
-		logMemoryRead(arg[0], arg[1]);
-		logTrace(_instruction, arg);
+		logTrace(_instruction, arg, logExternalMemoryRead(arg[0], arg[1]));
 		throw ExplicitlyTerminated();
 	case Instruction::INVALID:
 		logTrace(_instruction);
@@ -454,9 +455,21 @@ bool EVMInstructionInterpreter::logMemoryWrite(u256 const& _offset, u256 const&
 	return logMemory(true, _offset, _size, _data);
 }
 
+bytes EVMInstructionInterpreter::logExternalMemoryRead(u256 const& _offset, u256 const& _size)
+{
+	if (logMemoryRead(_offset, _size) && !m_state.traceWrites)
+		return m_state.memory.read(size_t(_offset), size_t(_size));
+	return {};
+}
+
 bool EVMInstructionInterpreter::logMemory(bool _write, u256 const& _offset, u256 const& _size, bytes const& _data)
 {
-	logTrace(_write ? "MSTORE_AT_SIZE" : "MLOAD_FROM_SIZE", {_offset, _size}, _data);
+	if (_write ? m_state.traceWrites : m_state.traceReads)
+		logTrace(
+			_write ? InterpreterTrace::PseudoOperation::MemoryWrite : InterpreterTrace::PseudoOperation::MemoryRead,
+			{_offset, _size},
+			_data
+		);
 
 	if (((_offset + _size) >= _offset) && ((_offset + _size + 0x1f) >= (_offset + _size)))
 	{
@@ -464,8 +477,7 @@ bool EVMInstructionInterpreter::logMemory(bool _write, u256 const& _offset, u256
 		m_state.msize = max(m_state.msize, newSize);
 		if (newSize < m_state.maxMemSize)
 		{
-			if (m_state.memory.size() < newSize)
-				m_state.memory.resize(size_t(newSize));
+			m_state.memory.extend(size_t(newSize));
 			return true;
 		}
 	}
@@ -477,21 +489,21 @@ bool EVMInstructionInterpreter::logMemory(bool _write, u256 const& _offset, u256
 
 void EVMInstructionInterpreter::logTrace(dev::eth::Instruction _instruction, std::vector<u256> const& _arguments, bytes const& _data)
 {
-	logTrace(dev::eth::instructionInfo(_instruction).name, _arguments, _data);
+	m_state.trace.append(_instruction, _arguments, _data);
+	checkTraceSize();
+}
+
+void EVMInstructionInterpreter::logTrace(InterpreterTrace::PseudoOperation _operation, std::vector<u256> const& _arguments, bytes const& _data)
+{
+	m_state.trace.append(_operation, _arguments, _data);
+	checkTraceSize();
 }
 
-void EVMInstructionInterpreter::logTrace(std::string const& _pseudoInstruction, std::vector<u256> const& _arguments, bytes const& _data)
+void EVMInstructionInterpreter::checkTraceSize()
 {
-	string message = _pseudoInstruction + "(";
-	for (size_t i = 0; i < _arguments.size(); ++i)
-		message += (i > 0 ? ", " : "") + formatNumber(_arguments[i]);
-	message += ")";
-	if (!_data.empty())
-		message += " [" + toHex(_data) + "]";
-	m_state.trace.emplace_back(std::move(message));
 	if (m_state.maxTraceSize > 0 && m_state.trace.size() >= m_state.maxTraceSize)
 	{
-		m_state.trace.emplace_back("Trace size limit reached.");
+		m_state.trace.append(InterpreterTrace::PseudoOperation::TraceLimitReached);
 		throw TraceLimitReached();
 	}
 }
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/InterpreterState.h>
+
 #include <libyul/AsmDataForward.h>
 
 #include <libdevcore/CommonData.h>
@@ -39,8 +41,6 @@ namespace yul
 namespace test
 {
 
-struct InterpreterState;
-
 /**
  * Interprets EVM instructions based on the current state and logs instructions with
  * side-effects.
@@ -76,12 +76,19 @@ private:
 	/// @returns true if m_state.memory can be used at that offset.
 	bool logMemoryWrite(dev::u256 const& _offset, dev::u256 const& _size = 32, dev::bytes const& _data = {});
 
+	/// Record a memory read of an operation that passes the memory area outside of the execution.
+	/// @returns the contents of the area if memory writes are not traced, because the trace
+	/// does not determine them then, and an empty vector otherwise.
+	dev::bytes logExternalMemoryRead(dev::u256 const& _offset, dev::u256 const& _size);
+
 	bool logMemory(bool _write, dev::u256 const& _offset, dev::u256 const& _size = 32, dev::bytes const& _data = {});
 
 	void logTrace(dev::eth::Instruction _instruction, std::vector<dev::u256> const& _arguments = {}, dev::bytes const& _data = {});
-	/// Appends a log to the trace representing an instruction or similar operation by string,
+	/// Appends a log to the trace representing an operation that is not an instruction,
 	/// with arguments and auxiliary data (if nonempty).
-	void logTrace(std::string const& _pseudoInstruction, std::vector<dev::u256> const& _arguments = {}, dev::bytes const& _data = {});
+	void logTrace(InterpreterTrace::PseudoOperation _operation, std::vector<dev::u256> const& _arguments = {}, dev::bytes const& _data = {});
+	/// Ends the execution if the trace reached its maximum size.
+	void checkTraceSize();
 
 	InterpreterState& m_state;
 };
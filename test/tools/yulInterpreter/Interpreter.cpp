@@ -110,6 +110,7 @@ void Interpreter::operator()(ForLoop const& _forLoop)
 		if (m_state.loopState == LoopState::Break)
 			break;
 
+		m_state.loopState = LoopState::Default;
 		(*this)(_forLoop.post);
 	}
 	m_state.loopState = LoopState::Default;
@@ -131,7 +132,7 @@ void Interpreter::operator()(Block const& _block)
 	m_state.numSteps++;
 	if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
 	{
-		m_state.trace.emplace_back("Interpreter execution step limit reached.");
+		m_state.trace.append(InterpreterTrace::PseudoOperation::StepLimitReached);
 		throw StepLimitReached();
 	}
 	openScope();
@@ -180,9 +181,6 @@ void Interpreter::closeScope()
 
 void ExpressionEvaluator::operator()(Literal const& _literal)
 {
-	static YulString const trueString("true");
-	static YulString const falseString("false");
-
 	setValue(valueOfLiteral(_literal));
 }
 
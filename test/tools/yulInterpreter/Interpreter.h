@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/InterpreterState.h>
+
 #include <libyul/AsmDataForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
@@ -51,47 +53,6 @@ class TraceLimitReached: public InterpreterTerminatedGeneric
 {
 };
 
-enum class LoopState
-{
-	Default,
-	Continue,
-	Break,
-};
-
-struct InterpreterState
-{
-	dev::bytes calldata;
-	dev::bytes returndata;
-	/// TODO turn this into "vector with holes" for the randomized testing
-	dev::bytes memory;
-	/// This is different than memory.size() because we ignore gas.
-	dev::u256 msize;
-	std::map<dev::h256, dev::h256> storage;
-	dev::u160 address = 0x11111111;
-	dev::u256 balance = 0x22222222;
-	dev::u160 origin = 0x33333333;
-	dev::u160 caller = 0x44444444;
-	dev::u256 callvalue = 0x55555555;
-	/// Deployed code
-	dev::bytes code = dev::asBytes("codecodecodecodecode");
-	dev::u256 gasprice = 0x66666666;
-	dev::u160 coinbase = 0x77777777;
-	dev::u256 timestamp = 0x88888888;
-	dev::u256 blockNumber = 1024;
-	dev::u256 difficulty = 0x9999999;
-	dev::u256 gaslimit = 4000000;
-	/// Log of changes / effects. Sholud be structured data in the future.
-	std::vector<std::string> trace;
-	/// This is actually an input parameter that more or less limits the runtime.
-	size_t maxTraceSize = 0;
-	/// Memory size limit. Anything beyond this will still work, but it has
-	/// deterministic yet not necessarily consistent behaviour.
-	size_t maxMemSize = 0x200;
-	size_t maxSteps = 0;
-	size_t numSteps = 0;
-	LoopState loopState = LoopState::Default;
-};
-
 /**
  * Yul interpreter.
  */
@@ -119,7 +80,7 @@ public:
 	void operator()(Continue const&) override;
 	void operator()(Block const& _block) override;
 
-	std::vector<std::string> const& trace() const { return m_state.trace; }
+	InterpreterTrace const& trace() const { return m_state.trace; }
 
 	dev::u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
 
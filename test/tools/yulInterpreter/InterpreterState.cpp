@@ -0,0 +1,180 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Memory, storage and trace of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/InterpreterState.h>
+
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <iomanip>
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+using namespace yul::test;
+
+uint8_t InterpreterMemory::byteAt(size_t _offset) const
+{
+	auto it = m_pages.find(_offset / pageSize);
+	return it == m_pages.end() ? 0 : it->second[_offset % pageSize];
+}
+
+bytes InterpreterMemory::read(size_t _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	for (size_t i = 0; i < _size;)
+	{
+		size_t offsetInPage = (_offset + i) % pageSize;
+		size_t chunk = min(_size - i, pageSize - offsetInPage);
+		auto it = m_pages.find((_offset + i) / pageSize);
+		if (it != m_pages.end())
+			copy_n(it->second.begin() + offsetInPage, chunk, data.begin() + i);
+		i += chunk;
+	}
+	return data;
+}
+
+void InterpreterMemory::write(size_t _offset, bytesConstRef _data)
+{
+	for (size_t i = 0; i < _data.size();)
+	{
+		size_t offsetInPage = (_offset + i) % pageSize;
+		size_t chunk = min(_data.size() - i, pageSize - offsetInPage);
+		copy_n(_data.begin() + i, chunk, page((_offset + i) / pageSize).begin() + offsetInPage);
+		i += chunk;
+	}
+}
+
+InterpreterMemory::Page& InterpreterMemory::page(size_t _index)
+{
+	auto it = m_pages.find(_index);
+	if (it == m_pages.end())
+	{
+		it = m_pages.emplace(_index, Page()).first;
+		it->second.fill(0);
+	}
+	return it->second;
+}
+
+void InterpreterTrace::append(eth::Instruction _instruction, vector<u256> const& _arguments, bytes const& _data)
+{
+	append(uint16_t(_instruction), _arguments, _data);
+}
+
+void InterpreterTrace::append(PseudoOperation _operation, vector<u256> const& _arguments, bytes const& _data)
+{
+	append(uint16_t(0x100 + uint16_t(_operation)), _arguments, _data);
+}
+
+void InterpreterTrace::append(uint16_t _operation, vector<u256> const& _arguments, bytes const& _data)
+{
+	yulAssert(_arguments.size() <= numeric_limits<uint16_t>::max(), "");
+	yulAssert(_data.size() <= numeric_limits<uint32_t>::max(), "");
+	m_entries.emplace_back(Entry{_operation, uint16_t(_arguments.size()), uint32_t(_data.size())});
+	m_arguments.insert(m_arguments.end(), _arguments.begin(), _arguments.end());
+	m_data.insert(m_data.end(), _data.begin(), _data.end());
+}
+
+string InterpreterTrace::line(size_t _index) const
+{
+	yulAssert(_index < m_entries.size(), "");
+	size_t firstArgument = 0;
+	size_t firstByte = 0;
+	for (size_t i = 0; i < _index; ++i)
+	{
+		firstArgument += m_entries[i].arguments;
+		firstByte += m_entries[i].data;
+	}
+	return line(m_entries[_index], firstArgument, firstByte);
+}
+
+vector<string> InterpreterTrace::lines() const
+{
+	vector<string> result;
+	size_t firstArgument = 0;
+	size_t firstByte = 0;
+	for (Entry const& entry: m_entries)
+	{
+		result.emplace_back(line(entry, firstArgument, firstByte));
+		firstArgument += entry.arguments;
+		firstByte += entry.data;
+	}
+	return result;
+}
+
+h256 InterpreterTrace::hash() const
+{
+	bytes serialized;
+	serialized.reserve(m_entries.size() * 8 + m_arguments.size() * 32 + m_data.size());
+	for (Entry const& entry: m_entries)
+	{
+		bytes encoded(8);
+		toBigEndian(uint64_t(entry.operation) << 48 | uint64_t(entry.arguments) << 32 | entry.data, encoded);
+		serialized += encoded;
+	}
+	for (u256 const& argument: m_arguments)
+		serialized += toBigEndian(argument);
+	serialized += m_data;
+	return keccak256(serialized);
+}
+
+string InterpreterTrace::line(Entry const& _entry, size_t _firstArgument, size_t _firstByte) const
+{
+	string name;
+	if (_entry.operation < 0x100)
+		name = eth::instructionInfo(eth::Instruction(_entry.operation)).name;
+	else
+		switch (PseudoOperation(_entry.operation - 0x100))
+		{
+		case PseudoOperation::MemoryRead:
+			name = "MLOAD_FROM_SIZE";
+			break;
+		case PseudoOperation::MemoryWrite:
+			name = "MSTORE_AT_SIZE";
+			break;
+		case PseudoOperation::TraceLimitReached:
+			return "Trace size limit reached.";
+		case PseudoOperation::StepLimitReached:
+			return "Interpreter execution step limit reached.";
+		}
+
+	string message = name + "(";
+	for (size_t i = 0; i < _entry.arguments; ++i)
+		message += (i > 0 ? ", " : "") + formatNumber(m_arguments[_firstArgument + i]);
+	message += ")";
+	if (_entry.data > 0)
+		message += " [" + toHex(bytesConstRef(m_data.data() + _firstByte, _entry.data).toBytes()) + "]";
+	return message;
+}
+
+void InterpreterState::dumpTraceAndState(ostream& _out) const
+{
+	_out << "Trace:" << endl;
+	for (auto const& line: trace.lines())
+		_out << "  " << line << endl;
+	_out << "Memory dump:" << endl;
+	for (size_t offset = 0; offset < memory.size(); offset += 0x20)
+		_out << "  " << std::hex << std::setw(4) << offset << ": " << toHex(memory.read(offset, 0x20)) << endl;
+	_out << "Storage dump:" << endl;
+	for (auto const& slot: map<h256, h256>(storage.begin(), storage.end()))
+		_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
+}
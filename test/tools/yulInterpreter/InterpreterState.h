@@ -0,0 +1,206 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Memory, storage and trace of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/FixedHash.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <array>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace yul
+{
+namespace test
+{
+
+/**
+ * Sparse memory that only allocates the pages that are written to. Reading bytes
+ * that have not been written to yields zero.
+ */
+class InterpreterMemory
+{
+public:
+	static size_t constexpr pageSize = 0x1000;
+	using Page = std::array<uint8_t, pageSize>;
+
+	/// @returns the size of the accessed part of the memory, which does not have to be allocated.
+	size_t size() const { return m_size; }
+	/// Extends the accessed part of the memory to at least @a _size bytes.
+	void extend(size_t _size) { m_size = std::max(m_size, _size); }
+
+	uint8_t byteAt(size_t _offset) const;
+	dev::bytes read(size_t _offset, size_t _size) const;
+	dev::u256 readWord(size_t _offset) const { return dev::u256(dev::h256(read(_offset, 32))); }
+
+	void setByte(size_t _offset, uint8_t _value) { page(_offset / pageSize)[_offset % pageSize] = _value; }
+	void write(size_t _offset, dev::bytesConstRef _data);
+	void writeWord(size_t _offset, dev::u256 const& _value) { write(_offset, dev::h256(_value).ref()); }
+
+private:
+	Page& page(size_t _index);
+
+	std::map<size_t, Page> m_pages;
+	size_t m_size = 0;
+};
+
+/**
+ * Compact log of the side-effects of an execution. Entries are stored in a binary
+ * format, so that recording them does not need any formatting and traces can be
+ * compared by their hash. The text format is only created when requested.
+ */
+class InterpreterTrace
+{
+public:
+	/// Entries that are not instructions.
+	enum class PseudoOperation: uint8_t
+	{
+		MemoryRead,
+		MemoryWrite,
+		TraceLimitReached,
+		StepLimitReached
+	};
+
+	void append(
+		dev::eth::Instruction _instruction,
+		std::vector<dev::u256> const& _arguments = {},
+		dev::bytes const& _data = {}
+	);
+	void append(
+		PseudoOperation _operation,
+		std::vector<dev::u256> const& _arguments = {},
+		dev::bytes const& _data = {}
+	);
+
+	size_t size() const { return m_entries.size(); }
+	bool empty() const { return m_entries.empty(); }
+	/// @returns true if the last entry is the given instruction.
+	bool endsWith(dev::eth::Instruction _instruction) const
+	{
+		return !empty() && m_entries.back().operation == uint16_t(_instruction);
+	}
+	/// @returns true if the last entry is the given pseudo operation.
+	bool endsWith(PseudoOperation _operation) const
+	{
+		return !empty() && m_entries.back().operation == 0x100 + uint16_t(_operation);
+	}
+
+	/// @returns the entry with the given index in the text format.
+	std::string line(size_t _index) const;
+	/// @returns all entries in the text format.
+	std::vector<std::string> lines() const;
+
+	/// @returns a hash of the entries that is equal for equal traces.
+	dev::h256 hash() const;
+
+	bool operator==(InterpreterTrace const& _other) const
+	{
+		return m_entries == _other.m_entries && m_arguments == _other.m_arguments && m_data == _other.m_data;
+	}
+	bool operator!=(InterpreterTrace const& _other) const { return !(*this == _other); }
+
+private:
+	struct Entry
+	{
+		/// Instruction or pseudo operation offset by 0x100.
+		uint16_t operation;
+		/// Number of arguments, stored in m_arguments after the arguments of the previous entries.
+		uint16_t arguments;
+		/// Number of bytes of data, stored in m_data after the data of the previous entries.
+		uint32_t data;
+
+		bool operator==(Entry const& _other) const
+		{
+			return operation == _other.operation && arguments == _other.arguments && data == _other.data;
+		}
+	};
+
+	void append(uint16_t _operation, std::vector<dev::u256> const& _arguments, dev::bytes const& _data);
+	std::string line(Entry const& _entry, size_t _firstArgument, size_t _firstByte) const;
+
+	std::vector<Entry> m_entries;
+	std::vector<dev::u256> m_arguments;
+	dev::bytes m_data;
+};
+
+enum class LoopState
+{
+	Default,
+	Continue,
+	Break,
+};
+
+struct InterpreterState
+{
+	struct StorageKeyHash
+	{
+		size_t operator()(dev::h256 const& _key) const { return boost::hash_range(_key.data(), _key.data() + _key.size); }
+	};
+
+	dev::bytes calldata;
+	dev::bytes returndata;
+	InterpreterMemory memory;
+	/// This is different than memory.size() because we ignore gas.
+	dev::u256 msize;
+	std::unordered_map<dev::h256, dev::h256, StorageKeyHash> storage;
+	dev::u160 address = 0x11111111;
+	dev::u256 balance = 0x22222222;
+	dev::u160 origin = 0x33333333;
+	dev::u160 caller = 0x44444444;
+	dev::u256 callvalue = 0x55555555;
+	/// Deployed code
+	dev::bytes code = dev::asBytes("codecodecodecodecode");
+	dev::u256 gasprice = 0x66666666;
+	dev::u160 coinbase = 0x77777777;
+	dev::u256 timestamp = 0x88888888;
+	dev::u256 blockNumber = 1024;
+	dev::u256 difficulty = 0x9999999;
+	dev::u256 gaslimit = 4000000;
+	/// Log of changes / effects.
+	InterpreterTrace trace;
+	/// This is actually an input parameter that more or less limits the runtime.
+	size_t maxTraceSize = 0;
+	/// Memory size limit. Anything beyond this will still work, but it has
+	/// deterministic yet not necessarily consistent behaviour.
+	size_t maxMemSize = 0x200;
+	size_t maxSteps = 0;
+	size_t numSteps = 0;
+	/// If false, reads from storage and memory are not added to the trace. They have no
+	/// effect outside of the execution and the optimiser is free to remove them.
+	bool traceReads = true;
+	/// If false, writes to storage and memory are not added to the trace. The memory passed to
+	/// operations that are visible outside of the execution is recorded with these operations.
+	bool traceWrites = true;
+	LoopState loopState = LoopState::Default;
+
+	/// Prints the trace, the accessed part of the memory and the storage in text format.
+	void dumpTraceAndState(std::ostream& _out) const;
+};
+
+}
+}
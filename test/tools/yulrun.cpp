@@ -19,6 +19,7 @@
  */
 
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmParser.h>
@@ -77,7 +78,7 @@ pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _source
 	}
 }
 
-void interpret(string const& _source)
+void interpret(string const& _source, bool _reference)
 {
 	shared_ptr<Block> ast;
 	shared_ptr<AsmAnalysisInfo> analysisInfo;
@@ -88,24 +89,21 @@ void interpret(string const& _source)
 	InterpreterState state;
 	state.maxTraceSize = 10000;
 	state.maxMemSize = 0x20000000;
-	Interpreter interpreter(state);
 	try
 	{
-		interpreter(*ast);
+		if (_reference)
+		{
+			Interpreter interpreter(state);
+			interpreter(*ast);
+		}
+		else
+			CompiledInterpreter(*ast).run(state);
 	}
 	catch (InterpreterTerminatedGeneric const&)
 	{
 	}
 
-	cout << "Trace:" << endl;
-	for (auto const& line: interpreter.trace())
-		cout << "  " << line << endl;
-	cout << "Memory dump:" << endl;
-	for (size_t i = 0; i < state.memory.size(); i += 0x20)
-		cout << "  " << std::hex << std::setw(4) << i << ": " << toHex(bytesConstRef(state.memory.data() + i, 0x20).toBytes()) << endl;
-	cout << "Storage dump:" << endl;
-	for (auto const& slot: state.storage)
-		cout << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
+	state.dumpTraceAndState(cout);
 }
 
 }
@@ -122,6 +120,7 @@ Allowed options)",
 		po::options_description::m_default_line_length - 23);
 	options.add_options()
 		("help", "Show this help screen.")
+		("reference", "Use the reference interpreter that walks the AST instead of the compiled interpreter.")
 		("input-file", po::value<vector<string>>(), "input file");
 	po::positional_options_description filesPositions;
 	filesPositions.add("input-file", -1);
@@ -151,7 +150,7 @@ Allowed options)",
 		else
 			input = readStandardInput();
 
-		interpret(input);
+		interpret(input, arguments.count("reference"));
 	}
 
 	return 0;